@@ -10,13 +10,161 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "reiz_eventMatrix.h"
+#include <string.h>
+#if EVENT_TIMER_ENABLE
+#include "reiz_eventMatrixTimer.h"
+#endif
+#if EVENT_TRACE_ENABLE
+#include "reiz_eventMatrixTrace.h"
+#endif
+#if EVENT_WAIT_ENABLE || EVENT_AFFINITY_ENABLE
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+#include <sched.h>
+#endif
 
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
+
+/* 事件标志位操作，事件标志可由其他线程设置时使用原子操作 */
+#if EVENT_WAIT_ENABLE || EVENT_SHARD_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+#define EVENT_FLAG_OR(x, m)                 __atomic_fetch_or(&(x), (m), __ATOMIC_SEQ_CST)
+#define EVENT_FLAG_AND(x, m)                __atomic_fetch_and(&(x), (m), __ATOMIC_SEQ_CST)
+#define EVENT_FLAG_LOAD(x)                  __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#else
+#define EVENT_FLAG_OR(x, m)                 ((x) |= (m))
+#define EVENT_FLAG_AND(x, m)                ((x) &= (m))
+#define EVENT_FLAG_LOAD(x)                  (x)
+#endif
+
+/* 事件发生次数计数读取及扣减，事件可由其他线程设置时使用原子操作，饱和递增见 eventMatrix_OccurInc() */
+#if EVENT_WAIT_ENABLE || EVENT_SHARD_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+#define EVENT_COUNT_LOAD(x)                 __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define EVENT_COUNT_SUB(x, n)               __atomic_fetch_sub(&(x), (n), __ATOMIC_RELAXED)
+#else
+#define EVENT_COUNT_LOAD(x)                 (x)
+#define EVENT_COUNT_SUB(x, n)               ((x) -= (n))
+#endif
+
+/* 事件所在事件标志矩阵行，使能事件优先级时位于该事件优先级类的标志矩阵中 */
+#if EVENT_PRIORITY_ENABLE
+#define EVENT_PRIO_GET(pEcb, row, col)      ((pEcb)->pEvPrioMatrix != NULL ? (*(pEcb)->pEvPrioMatrix)[row][col] : 0)
+#define EVENT_FLAG_ROW_AT(pFlag, rowNum, pEcb, row, col)    (pFlag)[EVENT_PRIO_GET(pEcb, row, col) * (rowNum) + (row)]
+#else
+#define EVENT_FLAG_ROW_AT(pFlag, rowNum, pEcb, row, col)    (pFlag)[row]
+#endif
+#define EVENT_FLAG_ROW(pEcb, row, col)      EVENT_FLAG_ROW_AT(*(pEcb)->pEvFlagMatrix, (pEcb)->matrixRow, pEcb, row, col)
+
+/* 事件使能掩码矩阵行，未使能掩码功能或未初始化时全部使能 */
+#if EVENT_ENABLE_MASK_ENABLE
+#define EVENT_ENABLE_ROW(pEcb, row)         ((pEcb)->pEvEnableMatrix != NULL ? (*(pEcb)->pEvEnableMatrix)[row] : (EVENT_FLAG_MATRIX_ROW_TYPE)~0)
+#else
+#define EVENT_ENABLE_ROW(pEcb, row)         ((EVENT_FLAG_MATRIX_ROW_TYPE)~0)
+#endif
+
+/* 读取事件亲和性，未初始化亲和性矩阵时不指定分发线程 */
+#if EVENT_AFFINITY_ENABLE
+#define EVENT_AFFINITY_GET(pEcb, row, col)  ((pEcb)->pEvAffinityMatrix != NULL ? (*(pEcb)->pEvAffinityMatrix)[row][col] : EVENT_AFFINITY_ANY)
+#endif
+
+/* 释放回调函数执行后的事件参数，使能延迟回收时放入回收列表 */
+#if EVENT_RECLAIM_ENABLE
+#define EVENT_PARA_FREE(pReclaim, pPara)    eventMatrix_ReclaimPut(pReclaim, pPara)
+#else
+#define EVENT_PARA_FREE(pReclaim, pPara)    free(pPara)
+#endif
+
+/* 设置事件标志时需逐事件处理的功能，使能时批量设置退化为逐事件设置 */
+#define EVENT_FLAG_PER_EVENT_HOOK           (EVENT_PRIORITY_ENABLE || EVENT_OCCUR_COUNT_ENABLE || EVENT_STAT_ENABLE || EVENT_TRACE_ENABLE)
+
+/* 事件回调函数及参数存储位置指针，使能稀疏存储时未注册事件无存储位置，为NULL */
+#if EVENT_MATRIX_SPARSE_ENABLE
+#define EVENT_CB_PTR(pEcb, row, col)        eventMatrix_SparseCbPtr(pEcb, row, col)
+#define EVENT_PARA_PTR(pEcb, row, col)      eventMatrix_SparseParaPtr(pEcb, row, col)
+#elif EVENT_MATRIX_AOS_ENABLE
+#define EVENT_CB_PTR(pEcb, row, col)        (&(*(pEcb)->pEvSlotMatrix)[row][col].pCb)
+#define EVENT_PARA_PTR(pEcb, row, col)      (&(*(pEcb)->pEvSlotMatrix)[row][col].para)
+#else
+#define EVENT_CB_PTR(pEcb, row, col)        (&(*(pEcb)->pEvCbMatrix)[row][col])
+#define EVENT_PARA_PTR(pEcb, row, col)      (&(*(pEcb)->pEvParaMatrix)[row][col])
+#endif
+
+/* 线程分片序号：未分配，事件处理线程直接写事件标志矩阵 */
+#define EVENT_SHARD_ID_NONE                 -1
+#define EVENT_SHARD_ID_DIRECT               -2
+
 /* Private typedef -----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if EVENT_SHARD_ENABLE
+static int              evShardNext = 0;                                        //下一个自动分配的分片序号
+static __thread int     evShardId   = EVENT_SHARD_ID_NONE;                      //本线程分片序号
+#endif
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static void eventMatrix_ecbOptionInit(pEcb_t pEcb);
+static int eventMatrix_BitCtz(EVENT_FLAG_MATRIX_ROW_TYPE bits);
+static bool eventMatrix_FlagMatrixProcess(pEcb_t pEcb, EVENT_FLAG_MATRIX_ROW_TYPE *pFlagRow);
+static bool eventMatrix_ProcessPass(pEcb_t pEcb);
+static void eventMatrix_ProcessPrepare(pEcb_t pEcb);
+static EVENT_FLAG_MATRIX_ROW_TYPE *eventMatrix_FlagEnter(pEcb_t pEcb, int eventFlag, int *pRowNum, uint32_t *pIdx);
+static void eventMatrix_FlagLeave(pEcb_t pEcb, uint32_t idx);
+#if EVENT_MATRIX_SPARSE_ENABLE
+static int eventMatrix_BitCount(EVENT_FLAG_MATRIX_ROW_TYPE bits);
+static evSlot_t *eventMatrix_SparseSlot(pEcb_t pEcb, int row, int col);
+static evSlot_t *eventMatrix_SparseSlotAlloc(pEcb_t pEcb, int row, int col);
+static pEventCB_t *eventMatrix_SparseCbPtr(pEcb_t pEcb, int row, int col);
+static evParaSlot_t *eventMatrix_SparseParaPtr(pEcb_t pEcb, int row, int col);
+#endif
+#if EVENT_PRIORITY_ENABLE
+static int eventMatrix_PrioClassProcess(pEcb_t pEcb, uint32_t pendMask);
+#endif
+#if EVENT_OCCUR_COUNT_ENABLE
+static void eventMatrix_OccurInc(uint32_t *pTimes);
+#endif
+#if EVENT_STAT_ENABLE
+static void eventMatrix_StatPost(pEcb_t pEcb, int eventFlag);
+static uint32_t eventMatrix_StatBegin(pEcb_t pEcb, int eventFlag);
+static void eventMatrix_StatEnd(pEcb_t pEcb, int eventFlag, uint32_t beginTime);
+#endif
+#if EVENT_RECLAIM_ENABLE
+static void eventMatrix_ReclaimInit(evReclaim_t *pReclaim, bool enable, pEvReclaimer_t pReclaimer);
+static void eventMatrix_ReclaimPut(evReclaim_t *pReclaim, void *pPara);
+static void eventMatrix_ReclaimFlush(evReclaim_t *pReclaim);
+static void *eventMatrix_ReclaimerThread(void *pArg);
+#endif
+#if EVENT_DEPEND_ENABLE
+static bool eventMatrix_DepBlocked(pEcb_t pEcb, int row, int col);
+static bool eventMatrix_DepReach(pEcb_t pEcb, int from, int to);
+#endif
+#if EVENT_AFFINITY_ENABLE
+static bool eventMatrix_AffinityRoute(pEvDispatcher_t pDisp, pEcb_t pEcb, int eventFlag, pEventCB_t pCb, evParaSlot_t *pPara);
+static bool eventMatrix_RoutePush(pEvDispatcher_t pDisp, pEcb_t pEcb, int eventFlag, pEventCB_t pCb, void *pPara);
+static bool eventMatrix_RouteIsEmpty(pEvDispatcher_t pDisp);
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+static void *eventMatrix_DynGrow(const void *pOld, size_t rowSize, int oldRow, int newRow, int fill);
+static uint32_t eventMatrix_DynReadLock(pEcb_t pEcb);
+static void eventMatrix_DynReadUnlock(pEcb_t pEcb, uint32_t idx);
+static void eventMatrix_DynSync(pEcb_t pEcb);
+#endif
+#if EVENT_SHARD_ENABLE
+static EVENT_FLAG_MATRIX_ROW_TYPE *eventMatrix_ShardGet(pEcb_t pEcb, evShardHead_t **ppHead);
+static void eventMatrix_ShardMark(evShardHead_t *pHead);
+static void eventMatrix_ShardMerge(pEcb_t pEcb);
+#endif
+#if EVENT_WAIT_ENABLE
+static bool eventMatrix_IsEmpty(pEcb_t pEcb);
+static void eventMatrix_WakeUp(pEcb_t pEcb);
+#endif
+#if EVENT_PARA_QUEUE_ENABLE
+static bool eventMatrix_ParaQueueDispatch(pEcb_t pEcb, pEventCB_t pCb, evParaQueue_t *pQueue);
+#endif
+#if EVENT_BATCH_CB_ENABLE
+static void eventMatrix_BatchCbStub(void *pPara);
+#endif
 
 /*******************************************************************************
  *  @brief  事件矩阵控制块初始化
@@ -28,6 +176,7 @@
  *  @return true          - 初始化成功
  *          false         - 初始化失败
  */
+#if !EVENT_MATRIX_SPARSE_ENABLE && !EVENT_MATRIX_AOS_ENABLE && !EVENT_MATRIX_DYNAMIC_ENABLE
 extern bool eventMatrix_ecbInit(    pEcb_t              pEcb,
                                     int                 matrixRow,
                                     pEvFlagMatrix_t     pEvFlagMatrix,
@@ -43,138 +192,2692 @@ extern bool eventMatrix_ecbInit(    pEcb_t              pEcb,
     pEcb->pEvFlagMatrix     =   pEvFlagMatrix;
     pEcb->pEvCbMatrix       =   pEvCbMatrix;
     pEcb->pEvParaMatrix     =   pEvParaMatrix;
+    eventMatrix_ecbOptionInit(pEcb);
 
     return true;
 }
+#endif
 
 /*******************************************************************************
- *  @brief  设置事件标志
- *  @param  pEcb      - 事件控制块指针
- *          eventName - 事件标志
- *  @return true      - 设置成功
- *          false     - 设置失败
+ *  @brief  槽位存储事件矩阵控制块初始化
+ *  @param  pEcb          - 事件控制块指针
+ *          matrixRow     - 矩阵行数
+ *          pEvFlagMatrix - 标志矩阵指针
+ *          pEvSlotMatrix - 事件槽位矩阵指针
+ *  @return true          - 初始化成功
+ *          false         - 初始化失败
  */
-extern bool eventMatrix_SetEventFlag(pEcb_t pEcb, int eventFlag) {
-    int row, col;
+#if EVENT_MATRIX_AOS_ENABLE && !EVENT_MATRIX_DYNAMIC_ENABLE
+extern bool eventMatrix_ecbSlotInit(pEcb_t              pEcb,
+                                    int                 matrixRow,
+                                    pEvFlagMatrix_t     pEvFlagMatrix,
+                                    pEvSlotMatrix_t     pEvSlotMatrix)
+{
+    if (pEcb == NULL || matrixRow == 0 || pEvFlagMatrix == NULL || pEvSlotMatrix == NULL) {
+        return false;
+    }
 
-    if (pEcb != NULL) {
-        row = eventFlag / EVENT_MATRIX_COL;
-        col = eventFlag % EVENT_MATRIX_COL;
-        (*pEcb->pEvFlagMatrix)[row] |= (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col;
-        return true;
+    pEcb->matrixRow         =   matrixRow;
+    pEcb->pEvFlagMatrix     =   pEvFlagMatrix;
+    pEcb->pEvSlotMatrix     =   pEvSlotMatrix;
+    eventMatrix_ecbOptionInit(pEcb);
+
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  稀疏存储事件矩阵控制块初始化，槽位数组于注册事件处理回调函数时分配
+ *  @param  pEcb            - 事件控制块指针
+ *          matrixRow       - 矩阵行数
+ *          pEvFlagMatrix   - 标志矩阵指针
+ *          pEvSparseMatrix - 稀疏事件矩阵指针
+ *  @return true            - 初始化成功
+ *          false           - 初始化失败
+ */
+#if EVENT_MATRIX_SPARSE_ENABLE && !EVENT_MATRIX_DYNAMIC_ENABLE
+extern bool eventMatrix_ecbSparseInit(  pEcb_t              pEcb,
+                                        int                 matrixRow,
+                                        pEvFlagMatrix_t     pEvFlagMatrix,
+                                        pEvSparseMatrix_t   pEvSparseMatrix)
+{
+    if (pEcb == NULL || matrixRow == 0 || pEvFlagMatrix == NULL || pEvSparseMatrix == NULL) {
+        return false;
     }
-    return false;
+
+    pEcb->matrixRow         =   matrixRow;
+    pEcb->pEvFlagMatrix     =   pEvFlagMatrix;
+    pEcb->pEvSparseMatrix   =   pEvSparseMatrix;
+    memset(pEvSparseMatrix, 0, matrixRow * sizeof(evSparseRow_t));
+    eventMatrix_ecbOptionInit(pEcb);
+
+    return true;
 }
+#endif
 
+#if EVENT_MATRIX_SPARSE_ENABLE
 /*******************************************************************************
- *  @brief  读取事件标志
- *  @param  pEcb      - 事件控制块指针
- *          eventName - 事件标志
- *  @return true      - 事件标志存在
- *          false     - 事件标志不存在
+ *  @brief  稀疏存储事件矩阵控制块去初始化，释放未处理参数及槽位数组
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
  */
-extern bool eventMatrix_GetEventFlag(pEcb_t pEcb, int eventFlag) {
-    int row, col;
+extern void eventMatrix_ecbSparseDeinit(pEcb_t pEcb) {
+    evSparseRow_t   *pRow;
+    uint32_t        i, num;
+    int             row;
+#if EVENT_PARA_QUEUE_ENABLE
+    uint32_t        j;
+#endif
 
-    if (pEcb != NULL) {
-        row = eventFlag / EVENT_MATRIX_COL;
-        col = eventFlag % EVENT_MATRIX_COL;
-        return (*pEcb->pEvFlagMatrix)[row] & ((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col) ? true : false;        
+    if (pEcb == NULL || pEcb->pEvSparseMatrix == NULL) {
+        return;
+    }
+
+    for (row = 0; row < pEcb->matrixRow; row++) {
+        pRow = &(*pEcb->pEvSparseMatrix)[row];
+        num = eventMatrix_BitCount(pRow->regMask);
+
+        for (i = 0; i < num; i++) {
+#if EVENT_PARA_QUEUE_ENABLE
+            for (j = 0; j < pRow->pSlotArr[i].para.count; j++) {
+                free(pRow->pSlotArr[i].para.pParaBuf[j]);
+            }
+#else
+            free(pRow->pSlotArr[i].para);
+#endif
+        }
+        free(pRow->pSlotArr);
+        memset(pRow, 0, sizeof(evSparseRow_t));
     }
-    return false;
 }
+#endif
 
 /*******************************************************************************
- *  @brief  清除事件标志
+ *  @brief  动态事件矩阵控制块初始化，按初始行数分配事件标志矩阵、回调函数及参数存储，
+ *          使能的事件优先级类、事件使能掩码及事件亲和性矩阵随之分配，无需另行初始化
  *  @param  pEcb      - 事件控制块指针
- *          eventName - 事件标志
- *  @return true      - 清除成功
- *          false     - 清除失败
+ *          matrixRow - 初始矩阵行数，注册事件时按需扩展
+ *  @return true      - 初始化成功
+ *          false     - 初始化失败
  */
-extern bool eventMatrix_ClearEventFlag(pEcb_t pEcb, int eventFlag) {
-    int row, col;
-
-    if (pEcb != NULL) {
-        row = eventFlag / EVENT_MATRIX_COL;
-        col = eventFlag % EVENT_MATRIX_COL;
-        (*pEcb->pEvFlagMatrix)[row] &= ~((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col);
-        return true;
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+extern bool eventMatrix_ecbDynInit(pEcb_t pEcb, int matrixRow) {
+    if (pEcb == NULL || matrixRow <= 0) {
+        return false;
     }
-    return false;
+
+    pEcb->matrixRow         =   0;
+    pEcb->pEvFlagMatrix     =   NULL;
+#if EVENT_MATRIX_SPARSE_ENABLE
+    pEcb->pEvSparseMatrix   =   NULL;
+#elif EVENT_MATRIX_AOS_ENABLE
+    pEcb->pEvSlotMatrix     =   NULL;
+#else
+    pEcb->pEvCbMatrix       =   NULL;
+    pEcb->pEvParaMatrix     =   NULL;
+#endif
+    eventMatrix_ecbOptionInit(pEcb);
+
+    return eventMatrix_Resize(pEcb, matrixRow);
 }
 
 /*******************************************************************************
- *  @brief  事件处理函数，轮询事件矩阵
+ *  @brief  动态事件矩阵控制块去初始化，释放未处理参数及各矩阵，须在其他线程停止设置事件标志后调用
  *  @param  pEcb - 事件控制块指针
  *  @return void
  */
-extern void eventMatrix_EventProcess(pEcb_t pEcb) {
-    int row, col, flag;
+extern void eventMatrix_ecbDynDeinit(pEcb_t pEcb) {
+#if !EVENT_MATRIX_SPARSE_ENABLE
+    evParaSlot_t *pPara;
+    int row, col;
+#if EVENT_PARA_QUEUE_ENABLE
+    uint32_t i;
+#endif
+#endif
 
-    if (pEcb == NULL) {
+    if (pEcb == NULL || pEcb->pDynFlag == NULL) {
         return;
     }
 
+#if EVENT_MATRIX_SPARSE_ENABLE
+    eventMatrix_ecbSparseDeinit(pEcb);
+    free(pEcb->pEvSparseMatrix);
+    pEcb->pEvSparseMatrix = NULL;
+#else
     for (row = 0; row < pEcb->matrixRow; row++) {
-        if (!(*pEcb->pEvFlagMatrix)[row]) {                                                 //该行无事件则跳过，继续下一行
-            continue;        
+        for (col = 0; col < (int)EVENT_MATRIX_COL; col++) {
+            pPara = EVENT_PARA_PTR(pEcb, row, col);
+#if EVENT_PARA_QUEUE_ENABLE
+            for (i = 0; i < pPara->count; i++) {
+                free(pPara->pParaBuf[i]);
+            }
+#else
+            free(*pPara);
+#endif
         }
+    }
+#if EVENT_MATRIX_AOS_ENABLE
+    free(pEcb->pEvSlotMatrix);
+    pEcb->pEvSlotMatrix = NULL;
+#else
+    free(pEcb->pEvCbMatrix);
+    free(pEcb->pEvParaMatrix);
+    pEcb->pEvCbMatrix   = NULL;
+    pEcb->pEvParaMatrix = NULL;
+#endif
+#endif
+#if EVENT_PRIORITY_ENABLE
+    free(pEcb->pEvPrioMatrix);
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    free(pEcb->pEvEnableMatrix);
+#endif
+#if EVENT_AFFINITY_ENABLE
+    free(pEcb->pEvAffinityMatrix);
+#endif
+#if EVENT_DEPEND_ENABLE
+    free(pEcb->pEvDepMatrix);
+#endif
+    free(pEcb->pDynFlag);
+    pEcb->pEvFlagMatrix = NULL;
+    pEcb->matrixRow     = 0;
+    eventMatrix_ecbOptionInit(pEcb);
+}
+
+/*******************************************************************************
+ *  @brief  扩展事件矩阵行数，须在事件处理线程中且不在事件处理回调函数中调用
+ *          分配新矩阵并复制后原子替换事件标志矩阵，等待仍在访问旧矩阵的设置线程退出后
+ *          将期间设置于旧矩阵的事件标志并入新矩阵，再释放旧矩阵，设置线程全程无锁
+ *  @param  pEcb      - 事件控制块指针
+ *          matrixRow - 新矩阵行数，不大于当前行数时不处理
+ *  @return true      - 扩展成功
+ *          false     - 扩展失败，原矩阵不变
+ */
+extern bool eventMatrix_Resize(pEcb_t pEcb, int matrixRow) {
+    evDynFlagMatrix_t *pNewFlag, *pOldFlag;
+    EVENT_FLAG_MATRIX_ROW_TYPE bits;
+    int oldRow, row, prio;
+#if EVENT_MATRIX_SPARSE_ENABLE
+    pEvSparseMatrix_t pNewSparse;
+#elif EVENT_MATRIX_AOS_ENABLE
+    pEvSlotMatrix_t pNewSlot;
+#else
+    pEvCbMatrix_t pNewCb;
+    pEvParaMatrix_t pNewPara;
+#endif
+#if EVENT_PRIORITY_ENABLE
+    pEvPrioMatrix_t pNewPrio;
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    pEvFlagMatrix_t pNewEnable;
+#endif
+#if EVENT_AFFINITY_ENABLE
+    pEvAffinityMatrix_t pNewAffinity;
+#endif
+#if EVENT_DEPEND_ENABLE
+    pEvFlagMatrix_t pNewDep;
+#endif
+    bool fail;
+
+    if (pEcb == NULL) {
+        return false;
+    }
+    if (matrixRow <= pEcb->matrixRow) {
+        return true;
+    }
+    if (pEcb->processing) {                                                     //事件处理期间矩阵不可移动
+        return false;
+    }
+#if EVENT_SHARD_ENABLE
+    if (pEcb->shardNum > 0 && matrixRow > pEcb->shardRowSize) {                //分片存储空间固定，不可超出
+        return false;
+    }
+#endif
+
+    oldRow   = pEcb->matrixRow;
+    pNewFlag = calloc(1, sizeof(evDynFlagMatrix_t) + EVENT_FLAG_OBJ_ROW(matrixRow) * sizeof(EVENT_FLAG_MATRIX_ROW_TYPE));
+    fail     = pNewFlag == NULL;
+#if EVENT_MATRIX_SPARSE_ENABLE
+    pNewSparse = eventMatrix_DynGrow(pEcb->pEvSparseMatrix, sizeof(evSparseRow_t), oldRow, matrixRow, 0);
+    fail |= pNewSparse == NULL;
+#elif EVENT_MATRIX_AOS_ENABLE
+    pNewSlot = eventMatrix_DynGrow(pEcb->pEvSlotMatrix, sizeof(evSlotRowArr_t), oldRow, matrixRow, 0);
+    fail |= pNewSlot == NULL;
+#else
+    pNewCb   = eventMatrix_DynGrow(pEcb->pEvCbMatrix, sizeof(evCbMatrixRowArr_t), oldRow, matrixRow, 0);
+    pNewPara = eventMatrix_DynGrow(pEcb->pEvParaMatrix, sizeof(evParaMatrixRowArr_t), oldRow, matrixRow, 0);
+    fail |= pNewCb == NULL || pNewPara == NULL;
+#endif
+#if EVENT_PRIORITY_ENABLE
+    pNewPrio = eventMatrix_DynGrow(pEcb->pEvPrioMatrix, sizeof(evPrioMatrixRowArr_t), oldRow, matrixRow, 0);
+    fail |= pNewPrio == NULL;
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    pNewEnable = eventMatrix_DynGrow(pEcb->pEvEnableMatrix, sizeof(EVENT_FLAG_MATRIX_ROW_TYPE), oldRow, matrixRow, 0xFF);  //新增行全部使能
+    fail |= pNewEnable == NULL;
+#endif
+#if EVENT_AFFINITY_ENABLE
+    pNewAffinity = eventMatrix_DynGrow(pEcb->pEvAffinityMatrix, sizeof(evAffinityMatrixRowArr_t), oldRow, matrixRow, EVENT_AFFINITY_ANY);
+    fail |= pNewAffinity == NULL;
+#endif
+#if EVENT_DEPEND_ENABLE
+    pNewDep = eventMatrix_DynGrow(pEcb->pEvDepMatrix, sizeof(EVENT_FLAG_MATRIX_ROW_TYPE), oldRow, matrixRow, 0);
+    fail |= pNewDep == NULL;
+#endif
 
-        for (col = 0; col < EVENT_MATRIX_COL; col++) {
-            flag = (*pEcb->pEvFlagMatrix)[row] & ((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col);    //获得事件标志
+    if (fail) {                                                                 //任一矩阵分配失败则全部释放，原矩阵不变
+        free(pNewFlag);
+#if EVENT_MATRIX_SPARSE_ENABLE
+        free(pNewSparse);
+#elif EVENT_MATRIX_AOS_ENABLE
+        free(pNewSlot);
+#else
+        free(pNewCb);
+        free(pNewPara);
+#endif
+#if EVENT_PRIORITY_ENABLE
+        free(pNewPrio);
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+        free(pNewEnable);
+#endif
+#if EVENT_AFFINITY_ENABLE
+        free(pNewAffinity);
+#endif
+#if EVENT_DEPEND_ENABLE
+        free(pNewDep);
+#endif
+        return false;
+    }
 
-            if (flag && (*pEcb->pEvCbMatrix)[row][col] != NULL) {                           //事件标志存在且回调函数存在则执行事件处理回调函数
-                (*pEcb->pEvCbMatrix)[row][col]((*pEcb->pEvParaMatrix)[row][col]);
+    /* 替换各矩阵指针，交换后 pNew* 为旧矩阵，设置线程可能仍在读取，同步后释放 */
+#if EVENT_MATRIX_SPARSE_ENABLE
+    pNewSparse      = __atomic_exchange_n(&pEcb->pEvSparseMatrix, pNewSparse, __ATOMIC_RELEASE);
+#elif EVENT_MATRIX_AOS_ENABLE
+    pNewSlot        = __atomic_exchange_n(&pEcb->pEvSlotMatrix, pNewSlot, __ATOMIC_RELEASE);
+#else
+    pNewCb          = __atomic_exchange_n(&pEcb->pEvCbMatrix, pNewCb, __ATOMIC_RELEASE);
+    pNewPara        = __atomic_exchange_n(&pEcb->pEvParaMatrix, pNewPara, __ATOMIC_RELEASE);
+#endif
+#if EVENT_PRIORITY_ENABLE
+    pNewPrio        = __atomic_exchange_n(&pEcb->pEvPrioMatrix, pNewPrio, __ATOMIC_RELEASE);
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    pNewEnable      = __atomic_exchange_n(&pEcb->pEvEnableMatrix, pNewEnable, __ATOMIC_RELEASE);
+#endif
+#if EVENT_AFFINITY_ENABLE
+    pNewAffinity    = __atomic_exchange_n(&pEcb->pEvAffinityMatrix, pNewAffinity, __ATOMIC_RELEASE);
+#endif
+#if EVENT_DEPEND_ENABLE
+    pNewDep         = __atomic_exchange_n(&pEcb->pEvDepMatrix, pNewDep, __ATOMIC_RELEASE);
+#endif
+    pNewFlag->matrixRow = matrixRow;
+    pOldFlag = __atomic_exchange_n(&pEcb->pDynFlag, pNewFlag, __ATOMIC_RELEASE);  //最后替换事件标志矩阵，设置线程读到新行数时其他矩阵均已替换
+    pEcb->pEvFlagMatrix = (pEvFlagMatrix_t)pNewFlag->flagArr;
+    pEcb->matrixRow     = matrixRow;
 
-                if ((*pEcb->pEvParaMatrix)[row][col] != NULL) {                             //检查参数集合数据结构内存是否释放，未释放则进行释放
-                    free((*pEcb->pEvParaMatrix)[row][col]);
-                    (*pEcb->pEvParaMatrix)[row][col] = NULL;
+    eventMatrix_DynSync(pEcb);                                                  //等待仍在访问旧矩阵的设置线程退出
+
+    if (pOldFlag != NULL) {                                                     //旧矩阵中的事件标志并入新矩阵，各优先级类行偏移随行数改变
+        for (prio = 0; prio < EVENT_FLAG_OBJ_ROW(1); prio++) {
+            for (row = 0; row < oldRow; row++) {
+                bits = __atomic_exchange_n(&pOldFlag->flagArr[prio * oldRow + row], 0, __ATOMIC_ACQUIRE);
+                if (bits) {
+                    EVENT_FLAG_OR(pNewFlag->flagArr[prio * matrixRow + row], bits);
                 }
-                (*pEcb->pEvFlagMatrix)[row] &= ~((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col);     //清除事件标志
             }
         }
+        free(pOldFlag);
     }
+#if EVENT_MATRIX_SPARSE_ENABLE
+    free(pNewSparse);                                                           //槽位数组已随行移入新矩阵，仅释放行数组
+#elif EVENT_MATRIX_AOS_ENABLE
+    free(pNewSlot);
+#else
+    free(pNewCb);
+    free(pNewPara);
+#endif
+#if EVENT_PRIORITY_ENABLE
+    free(pNewPrio);
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    free(pNewEnable);
+#endif
+#if EVENT_AFFINITY_ENABLE
+    free(pNewAffinity);
+#endif
+#if EVENT_DEPEND_ENABLE
+    free(pNewDep);
+#endif
+    return true;
 }
+#endif
 
 /*******************************************************************************
- *  @brief  保存事件参数集合数据结构指针，以供事件处理回调函数使用
+ *  @brief  事件控制块可选功能成员初始化
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+static void eventMatrix_ecbOptionInit(pEcb_t pEcb) {
+    (void)pEcb;                                                                 //可选功能均未使能时不使用
+#if EVENT_PRIORITY_ENABLE
+    pEcb->pEvPrioMatrix     =   NULL;
+    pEcb->prioMask          =   0;
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    pEcb->pEvEnableMatrix   =   NULL;
+#endif
+#if EVENT_AFFINITY_ENABLE
+    pEcb->pEvAffinityMatrix =   NULL;
+    pEcb->pDispatcherArr    =   NULL;
+    pEcb->dispatcherNum     =   0;
+#endif
+#if EVENT_RTC_ENABLE
+    pEcb->budget            =   UINT32_MAX;
+#endif
+#if EVENT_RECLAIM_ENABLE
+    eventMatrix_ReclaimInit(&pEcb->reclaim, false, NULL);
+#endif
+#if EVENT_DEPEND_ENABLE
+    pEcb->pEvDepMatrix      =   NULL;
+    pEcb->pDepArr           =   NULL;
+    pEcb->depNum            =   0;
+    pEcb->depCap            =   0;
+#endif
+#if EVENT_SHARD_ENABLE
+    pEcb->pShardHead        =   NULL;
+    pEcb->pShardFlag        =   NULL;
+    pEcb->shardNum          =   0;
+    pEcb->shardRowSize      =   0;
+#endif
+#if EVENT_WAIT_ENABLE
+    pEcb->waitFd            =   -1;
+    pEcb->waitArmed         =   0;
+#endif
+#if EVENT_TIMER_ENABLE
+    pEcb->pTimer            =   NULL;
+#endif
+#if EVENT_STAT_ENABLE
+    pEcb->pEvStatTable      =   NULL;
+    pEcb->statNum           =   0;
+    pEcb->pStatGetTime      =   NULL;
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    pEcb->pDynFlag          =   NULL;
+    pEcb->dynGen            =   0;
+    pEcb->dynRef[0]         =   0;
+    pEcb->dynRef[1]         =   0;
+#endif
+#if EVENT_MATRIX_SPARSE_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+    pEcb->processing        =   false;
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  事件优先级类矩阵初始化，未初始化时所有事件均为最低优先级类0
+ *  @param  pEcb          - 事件控制块指针
+ *          pEvPrioMatrix - 事件优先级类矩阵指针
+ *  @return true          - 初始化成功
+ *          false         - 初始化失败
+ */
+#if EVENT_PRIORITY_ENABLE
+extern bool eventMatrix_ecbPrioInit(pEcb_t pEcb, pEvPrioMatrix_t pEvPrioMatrix) {
+    if (pEcb == NULL || pEvPrioMatrix == NULL) {
+        return false;
+    }
+
+    pEcb->pEvPrioMatrix     =   pEvPrioMatrix;
+
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件亲和性初始化，亲和性矩阵清零即全部事件不指定分发线程
+ *  @param  pEcb              - 事件控制块指针
+ *          pEvAffinityMatrix - 事件亲和性矩阵指针，动态事件矩阵传入NULL
+ *          pDispatcherArr    - 事件分发线程指针数组，各分发线程须已初始化
+ *          dispatcherNum     - 事件分发线程数，1 ~ 255
+ *  @return true              - 初始化成功
+ *          false             - 初始化失败
+ */
+#if EVENT_AFFINITY_ENABLE
+extern bool eventMatrix_ecbAffinityInit(pEcb_t              pEcb,
+                                        pEvAffinityMatrix_t pEvAffinityMatrix,
+                                        pEvDispatcher_t     *pDispatcherArr,
+                                        int                 dispatcherNum)
+{
+    int i;
+
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    if (pEcb != NULL && pEvAffinityMatrix == NULL) {                            //动态事件矩阵使用随矩阵扩展的亲和性矩阵
+        pEvAffinityMatrix = pEcb->pEvAffinityMatrix;
+    }
+#endif
+    if (pEcb == NULL || pEvAffinityMatrix == NULL || pDispatcherArr == NULL || dispatcherNum <= 0 || dispatcherNum > UINT8_MAX) {
+        return false;
+    }
+    for (i = 0; i < dispatcherNum; i++) {
+        if (pDispatcherArr[i] == NULL) {
+            return false;
+        }
+    }
+
+    memset(pEvAffinityMatrix, 0, pEcb->matrixRow * sizeof(evAffinityMatrixRowArr_t));
+    pEcb->pEvAffinityMatrix =   pEvAffinityMatrix;
+    pEcb->pDispatcherArr    =   pDispatcherArr;
+    pEcb->dispatcherNum     =   dispatcherNum;
+
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件依赖初始化，清空依赖表
+ *  @param  pEcb         - 事件控制块指针
+ *          pEvDepMatrix - 消费者位图矩阵指针，动态事件矩阵传入NULL
+ *          pDepArr      - 事件依赖数组指针
+ *          depCap       - 事件依赖数组容量
+ *  @return true         - 初始化成功
+ *          false        - 初始化失败
+ */
+#if EVENT_DEPEND_ENABLE
+extern bool eventMatrix_ecbDepInit(pEcb_t pEcb, pEvFlagMatrix_t pEvDepMatrix, pEvDep_t pDepArr, int depCap) {
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    if (pEcb != NULL && pEvDepMatrix == NULL) {                                 //动态事件矩阵使用随矩阵扩展的消费者位图矩阵
+        pEvDepMatrix = pEcb->pEvDepMatrix;
+    }
+#endif
+    if (pEcb == NULL || pEvDepMatrix == NULL || pDepArr == NULL || depCap <= 0) {
+        return false;
+    }
+
+    memset(pEvDepMatrix, 0, pEcb->matrixRow * sizeof(EVENT_FLAG_MATRIX_ROW_TYPE));
+    pEcb->pEvDepMatrix  =   pEvDepMatrix;
+    pEcb->pDepArr       =   pDepArr;
+    pEcb->depNum        =   0;
+    pEcb->depCap        =   depCap;
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  添加事件依赖，生产者与消费者事件同时待处理时先处理生产者事件，
+ *          消费者事件推迟至生产者事件处理后，须在事件处理线程中调用
+ *  @param  pEcb     - 事件控制块指针
+ *          producer - 生产者事件标志
+ *          consumer - 消费者事件标志
+ *  @return true     - 添加成功，依赖已存在时亦返回true
+ *          false    - 添加失败，事件标志无效、依赖表满或形成依赖环
+ */
+extern bool eventMatrix_AddEventDep(pEcb_t pEcb, int producer, int consumer) {
+    int i, maxFlag;
+
+    if (pEcb == NULL || pEcb->pEvDepMatrix == NULL) {
+        return false;
+    }
+    maxFlag = pEcb->matrixRow * EVENT_MATRIX_COL;
+    if (producer < 0 || producer >= maxFlag || consumer < 0 || consumer >= maxFlag || producer == consumer) {
+        return false;
+    }
+    for (i = 0; i < pEcb->depNum; i++) {
+        if (pEcb->pDepArr[i].producer == producer && pEcb->pDepArr[i].consumer == consumer) {
+            return true;
+        }
+    }
+    if (pEcb->depNum >= pEcb->depCap || eventMatrix_DepReach(pEcb, consumer, producer)) {   //消费者可达生产者时形成环
+        return false;
+    }
+
+    pEcb->pDepArr[pEcb->depNum].producer = producer;
+    pEcb->pDepArr[pEcb->depNum].consumer = consumer;
+    pEcb->pDepArr[pEcb->depNum].visit    = false;
+    pEcb->depNum++;
+    (*pEcb->pEvDepMatrix)[consumer / EVENT_MATRIX_COL] |= (EVENT_FLAG_MATRIX_ROW_TYPE)1 << (consumer % EVENT_MATRIX_COL);
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  删除事件依赖，须在事件处理线程中调用
+ *  @param  pEcb     - 事件控制块指针
+ *          producer - 生产者事件标志
+ *          consumer - 消费者事件标志
+ *  @return true     - 删除成功
+ *          false    - 依赖不存在
+ */
+extern bool eventMatrix_RemoveEventDep(pEcb_t pEcb, int producer, int consumer) {
+    int i;
+    bool found = false, remain = false;
+
+    if (pEcb == NULL || pEcb->pEvDepMatrix == NULL) {
+        return false;
+    }
+
+    for (i = 0; i < pEcb->depNum; i++) {
+        if (!found && pEcb->pDepArr[i].producer == producer && pEcb->pDepArr[i].consumer == consumer) {
+            pEcb->pDepArr[i] = pEcb->pDepArr[--pEcb->depNum];                   //末尾依赖移入空位
+            found = true;
+        }
+        if (i < pEcb->depNum && pEcb->pDepArr[i].consumer == consumer) {
+            remain = true;
+        }
+    }
+    if (found && !remain) {                                                     //消费者已无其他生产者
+        (*pEcb->pEvDepMatrix)[consumer / EVENT_MATRIX_COL] &= ~((EVENT_FLAG_MATRIX_ROW_TYPE)1 << (consumer % EVENT_MATRIX_COL));
+    }
+
+    return found;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  设置事件标志
  *  @param  pEcb      - 事件控制块指针
- *          eventFlag - 事件标志
- *          pPara     - 事件参数集合数据结构指针
- *  @return true      - 保存成功
- *          false     - 保存失败
+ *          eventName - 事件标志
+ *  @return true      - 设置成功
+ *          false     - 设置失败
  */
-extern bool eventMatrix_SaveEventPara(pEcb_t pEcb, int eventFlag, void *pPara) {
-    int row, col;
+extern bool eventMatrix_SetEventFlag(pEcb_t pEcb, int eventFlag) {
+    EVENT_FLAG_MATRIX_ROW_TYPE *pFlag;
+    int row, col, rowNum;
+    uint32_t idx;
+#if EVENT_OCCUR_COUNT_ENABLE
+    evParaSlot_t *pPara;
+#endif
+#if EVENT_SHARD_ENABLE
+    EVENT_FLAG_MATRIX_ROW_TYPE *pShardRow;
+    evShardHead_t *pHead;
+#endif
+#if EVENT_STAT_ENABLE
+    bool first;
+#endif
 
     if (pEcb != NULL) {
         row = eventFlag / EVENT_MATRIX_COL;
         col = eventFlag % EVENT_MATRIX_COL;
-        (*pEcb->pEvParaMatrix)[row][col] = pPara;
+        pFlag = eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx);
+        if (pFlag == NULL) {
+            return false;
+        }
+        (void)rowNum;                                                           //未使能事件优先级时不使用行数
+#if EVENT_TRACE_ENABLE
+        eventMatrix_TraceRecord(EV_TRACE_TYPE_SET, eventFlag, 0);
+#endif
+#if EVENT_OCCUR_COUNT_ENABLE
+        pPara = EVENT_PARA_PTR(pEcb, row, col);
+        if (pPara != NULL) {                                                    //先计数后设置标志，分发线程见到标志时必已计入本次
+            eventMatrix_OccurInc(&pPara->occurTimes);
+        }
+#endif
+#if EVENT_SHARD_ENABLE
+        pShardRow = eventMatrix_ShardGet(pEcb, &pHead);
+#endif
+#if EVENT_STAT_ENABLE
+        first = true;
+#if EVENT_SHARD_ENABLE
+        if (pShardRow != NULL) {                                                //先查分片，合并中移入矩阵的标志随后在矩阵中查到
+            first = !(__atomic_load_n(&pShardRow[row], __ATOMIC_SEQ_CST) & ((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col));
+        }
+#endif
+        if (first && !(EVENT_FLAG_ROW_AT(pFlag, rowNum, pEcb, row, col) & ((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col))) {   //首次设置时记录时间
+            eventMatrix_StatPost(pEcb, eventFlag);
+        }
+#endif
+#if EVENT_SHARD_ENABLE
+        if (pShardRow != NULL) {                                                //本线程有分片时写入分片，分片行不与其他设置线程共享缓存行
+            __atomic_fetch_or(&pShardRow[row], (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col, __ATOMIC_SEQ_CST);
+            eventMatrix_ShardMark(pHead);
+        } else                                                                  //本线程无分片时直接写事件标志矩阵
+#endif
+        {
+            EVENT_FLAG_OR(EVENT_FLAG_ROW_AT(pFlag, rowNum, pEcb, row, col), (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col);
+#if EVENT_PRIORITY_ENABLE
+            EVENT_FLAG_OR(pEcb->prioMask, (uint32_t)1 << EVENT_PRIO_GET(pEcb, row, col));
+#endif
+        }
+#if EVENT_WAIT_ENABLE
+        eventMatrix_WakeUp(pEcb);
+#endif
+        eventMatrix_FlagLeave(pEcb, idx);
         return true;
     }
     return false;
 }
 
 /*******************************************************************************
- *  @brief  注册事件处理回调函数
+ *  @brief  批量设置事件标志列表，逐事件处理的功能均未使能时仅写事件标志矩阵或本线程分片，并只唤醒一次
  *  @param  pEcb      - 事件控制块指针
- *          eventFlag - 事件标志
- *          pCb       - 事件处理回调函数指针
- *  @return true      - 注册成功
- *          false     - 注册失败
+ *          pEventArr - 事件标志数组指针
+ *          eventNum  - 事件标志个数
+ *  @return true      - 设置成功
+ *          false     - 设置失败
  */
-extern bool eventMatrix_RegistEvCB(pEcb_t pEcb, int eventFlag, pEventCB_t pCb) {
-    int row, col;
+extern bool eventMatrix_SetEventFlagList(pEcb_t pEcb, const int *pEventArr, int eventNum) {
+#if !EVENT_FLAG_PER_EVENT_HOOK
+    EVENT_FLAG_MATRIX_ROW_TYPE *pFlagRow;
+    unsigned int eventFlag, rowNum;
+#endif
+#if EVENT_SHARD_ENABLE && !EVENT_FLAG_PER_EVENT_HOOK
+    EVENT_FLAG_MATRIX_ROW_TYPE *pShardRow;
+    evShardHead_t *pHead;
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE && !EVENT_FLAG_PER_EVENT_HOOK
+    evDynFlagMatrix_t *pDyn;
+    uint32_t idx;
+#endif
+    int i;
 
-    if (pEcb != NULL) {
-        row = eventFlag / EVENT_MATRIX_COL;
-        col = eventFlag % EVENT_MATRIX_COL;
-        (*pEcb->pEvCbMatrix)[row][col] = pCb;
-        return true;
+    if (pEcb == NULL || pEventArr == NULL || eventNum < 0) {
+        return false;
+    }
+
+#if EVENT_FLAG_PER_EVENT_HOOK
+    for (i = 0; i < eventNum; i++) {
+        eventMatrix_SetEventFlag(pEcb, pEventArr[i]);
+    }
+#else
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    idx  = eventMatrix_DynReadLock(pEcb);
+    pDyn = __atomic_load_n(&pEcb->pDynFlag, __ATOMIC_ACQUIRE);
+    pFlagRow = pDyn->flagArr;
+    rowNum   = (unsigned int)pDyn->matrixRow;
+#else
+    pFlagRow = *pEcb->pEvFlagMatrix;
+    rowNum   = (unsigned int)pEcb->matrixRow;
+#endif
+#if EVENT_SHARD_ENABLE
+    pShardRow = eventMatrix_ShardGet(pEcb, &pHead);
+    if (pShardRow != NULL) {                                                    //本线程有分片时写入分片，由事件处理线程合并
+        pFlagRow = pShardRow;
+    }
+#endif
+    for (i = 0; i < eventNum; i++) {
+        eventFlag = (unsigned int)pEventArr[i];                                 //无符号除法及取余编译为移位及掩码
+        if (eventFlag / EVENT_MATRIX_COL >= rowNum) {                           //负数及超出当前行数的事件忽略
+            continue;
+        }
+        EVENT_FLAG_OR(pFlagRow[eventFlag / EVENT_MATRIX_COL],
+                      (EVENT_FLAG_MATRIX_ROW_TYPE)1 << (eventFlag % EVENT_MATRIX_COL));
+    }
+#if EVENT_SHARD_ENABLE
+    if (pShardRow != NULL && eventNum > 0) {
+        eventMatrix_ShardMark(pHead);
+    }
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_DynReadUnlock(pEcb, idx);
+#endif
+#endif
+
+#if EVENT_WAIT_ENABLE && !EVENT_FLAG_PER_EVENT_HOOK
+    if (eventNum > 0) {
+        eventMatrix_WakeUp(pEcb);
+    }
+#endif
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  按行位图批量设置事件标志，位图第row个元素第col位对应事件 row * EVENT_MATRIX_COL + col
+ *          逐事件处理的功能均未使能时按字或入事件标志矩阵，本线程有分片时或入分片，
+ *          未使能事件等待、分片及动态事件标志矩阵时编译器可向量化
+ *  @param  pEcb    - 事件控制块指针
+ *          pBitmap - 事件位图指针
+ *          rowNum  - 位图行数，不可大于矩阵行数
+ *  @return true    - 设置成功
+ *          false   - 设置失败
+ */
+extern bool eventMatrix_SetEventFlagBitmap(pEcb_t pEcb, const EVENT_FLAG_MATRIX_ROW_TYPE *pBitmap, int rowNum) {
+    int row;
+#if EVENT_FLAG_PER_EVENT_HOOK
+    EVENT_FLAG_MATRIX_ROW_TYPE bits;
+#else
+    EVENT_FLAG_MATRIX_ROW_TYPE *pFlagRow;
+#endif
+#if (EVENT_WAIT_ENABLE || EVENT_SHARD_ENABLE) && !EVENT_FLAG_PER_EVENT_HOOK
+    bool set = false;
+#endif
+#if EVENT_SHARD_ENABLE && !EVENT_FLAG_PER_EVENT_HOOK
+    EVENT_FLAG_MATRIX_ROW_TYPE *pShardRow;
+    evShardHead_t *pHead;
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE && !EVENT_FLAG_PER_EVENT_HOOK
+    evDynFlagMatrix_t *pDyn;
+    uint32_t idx;
+#endif
+
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    if (pEcb == NULL || pBitmap == NULL || rowNum < 0) {                        //行数于事件标志矩阵快照中检查
+        return false;
+    }
+#else
+    if (pEcb == NULL || pBitmap == NULL || rowNum < 0 || rowNum > pEcb->matrixRow) {
+        return false;
+    }
+#endif
+
+#if EVENT_FLAG_PER_EVENT_HOOK
+    for (row = 0; row < rowNum; row++) {
+        for (bits = pBitmap[row]; bits; bits &= bits - 1) {
+            eventMatrix_SetEventFlag(pEcb, row * EVENT_MATRIX_COL + eventMatrix_BitCtz(bits));
+        }
+    }
+#else
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    idx  = eventMatrix_DynReadLock(pEcb);
+    pDyn = __atomic_load_n(&pEcb->pDynFlag, __ATOMIC_ACQUIRE);
+    if (rowNum > pDyn->matrixRow) {
+        eventMatrix_DynReadUnlock(pEcb, idx);
+        return false;
+    }
+    pFlagRow = pDyn->flagArr;
+#else
+    pFlagRow = *pEcb->pEvFlagMatrix;
+#endif
+#if EVENT_SHARD_ENABLE
+    pShardRow = eventMatrix_ShardGet(pEcb, &pHead);
+    if (pShardRow != NULL) {                                                    //本线程有分片时写入分片，由事件处理线程合并
+        pFlagRow = pShardRow;
+    }
+#endif
+#if EVENT_WAIT_ENABLE || EVENT_SHARD_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+    for (row = 0; row < rowNum; row++) {
+        if (pBitmap[row]) {                                                     //原子操作只用于非零字
+            EVENT_FLAG_OR(pFlagRow[row], pBitmap[row]);
+#if EVENT_WAIT_ENABLE || EVENT_SHARD_ENABLE
+            set = true;
+#endif
+        }
+    }
+#if EVENT_SHARD_ENABLE
+    if (pShardRow != NULL && set) {
+        eventMatrix_ShardMark(pHead);
+    }
+#endif
+#if EVENT_WAIT_ENABLE
+    if (set) {
+        eventMatrix_WakeUp(pEcb);
+    }
+#endif
+#else
+    for (row = 0; row + 4 <= rowNum; row += 4) {                                //每次读取4字后统一写回，编译器可合并为一次向量或运算
+        EVENT_FLAG_MATRIX_ROW_TYPE f0 = pFlagRow[row]     | pBitmap[row];
+        EVENT_FLAG_MATRIX_ROW_TYPE f1 = pFlagRow[row + 1] | pBitmap[row + 1];
+        EVENT_FLAG_MATRIX_ROW_TYPE f2 = pFlagRow[row + 2] | pBitmap[row + 2];
+        EVENT_FLAG_MATRIX_ROW_TYPE f3 = pFlagRow[row + 3] | pBitmap[row + 3];
+
+        pFlagRow[row]     = f0;
+        pFlagRow[row + 1] = f1;
+        pFlagRow[row + 2] = f2;
+        pFlagRow[row + 3] = f3;
+    }
+    for (; row < rowNum; row++) {
+        pFlagRow[row] |= pBitmap[row];
+    }
+#endif
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_DynReadUnlock(pEcb, idx);
+#endif
+#endif
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  事件使能掩码矩阵初始化，初始全部使能，未初始化时全部使能
+ *  @param  pEcb            - 事件控制块指针
+ *          pEvEnableMatrix - 事件使能掩码矩阵指针
+ *  @return true            - 初始化成功
+ *          false           - 初始化失败
+ */
+#if EVENT_ENABLE_MASK_ENABLE
+extern bool eventMatrix_ecbEnableInit(pEcb_t pEcb, pEvFlagMatrix_t pEvEnableMatrix) {
+    if (pEcb == NULL || pEvEnableMatrix == NULL) {
+        return false;
+    }
+
+    memset(pEvEnableMatrix, 0xFF, pEcb->matrixRow * sizeof(EVENT_FLAG_MATRIX_ROW_TYPE));
+    pEcb->pEvEnableMatrix   =   pEvEnableMatrix;
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  按行位图解除屏蔽事件，屏蔽期间设置的事件标志随后处理
+ *  @param  pEcb    - 事件控制块指针
+ *          pBitmap - 事件位图指针
+ *          rowNum  - 位图行数，不可大于矩阵行数
+ *  @return true    - 设置成功
+ *          false   - 设置失败
+ */
+extern bool eventMatrix_EnableEventBitmap(pEcb_t pEcb, const EVENT_FLAG_MATRIX_ROW_TYPE *pBitmap, int rowNum) {
+    int row;
+
+    if (pEcb == NULL || pEcb->pEvEnableMatrix == NULL || pBitmap == NULL || rowNum < 0 || rowNum > pEcb->matrixRow) {
+        return false;
+    }
+
+    for (row = 0; row < rowNum; row++) {
+        EVENT_FLAG_OR((*pEcb->pEvEnableMatrix)[row], pBitmap[row]);
+    }
+#if EVENT_PRIORITY_ENABLE
+    EVENT_FLAG_OR(pEcb->prioMask, (uint32_t)0xFFFFFFFF >> (32 - EVENT_PRIORITY_CLASS_NUM)); //屏蔽期间待处理事件所在优先级类未知，全部标记待处理
+#endif
+#if EVENT_WAIT_ENABLE
+    eventMatrix_WakeUp(pEcb);
+#endif
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  按行位图屏蔽事件，屏蔽期间事件标志仍可设置但不处理
+ *  @param  pEcb    - 事件控制块指针
+ *          pBitmap - 事件位图指针
+ *          rowNum  - 位图行数，不可大于矩阵行数
+ *  @return true    - 设置成功
+ *          false   - 设置失败
+ */
+extern bool eventMatrix_DisableEventBitmap(pEcb_t pEcb, const EVENT_FLAG_MATRIX_ROW_TYPE *pBitmap, int rowNum) {
+    int row;
+
+    if (pEcb == NULL || pEcb->pEvEnableMatrix == NULL || pBitmap == NULL || rowNum < 0 || rowNum > pEcb->matrixRow) {
+        return false;
+    }
+
+    for (row = 0; row < rowNum; row++) {
+        EVENT_FLAG_AND((*pEcb->pEvEnableMatrix)[row], ~pBitmap[row]);
+    }
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  读取事件标志
+ *  @param  pEcb      - 事件控制块指针
+ *          eventName - 事件标志
+ *  @return true      - 事件标志存在
+ *          false     - 事件标志不存在
+ */
+extern bool eventMatrix_GetEventFlag(pEcb_t pEcb, int eventFlag) {
+    EVENT_FLAG_MATRIX_ROW_TYPE *pFlag;
+    int row, col, rowNum;
+    uint32_t idx;
+    bool set;
+
+    if (pEcb != NULL) {
+        row = eventFlag / EVENT_MATRIX_COL;
+        col = eventFlag % EVENT_MATRIX_COL;
+        pFlag = eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx);
+        if (pFlag == NULL) {
+            return false;
+        }
+#if EVENT_SHARD_ENABLE
+        eventMatrix_ShardMerge(pEcb);
+#endif
+        set = EVENT_FLAG_ROW_AT(pFlag, rowNum, pEcb, row, col) & ((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col) ? true : false;
+        eventMatrix_FlagLeave(pEcb, idx);
+        return set;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  清除事件标志
+ *  @param  pEcb      - 事件控制块指针
+ *          eventName - 事件标志
+ *  @return true      - 清除成功
+ *          false     - 清除失败
+ */
+extern bool eventMatrix_ClearEventFlag(pEcb_t pEcb, int eventFlag) {
+    EVENT_FLAG_MATRIX_ROW_TYPE *pFlag;
+    int row, col, rowNum;
+    uint32_t idx;
+
+    if (pEcb != NULL) {
+        row = eventFlag / EVENT_MATRIX_COL;
+        col = eventFlag % EVENT_MATRIX_COL;
+        pFlag = eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx);
+        if (pFlag == NULL) {
+            return false;
+        }
+#if EVENT_SHARD_ENABLE
+        eventMatrix_ShardMerge(pEcb);                                           //先合并分片，避免分片中的标志随后重新出现
+#endif
+        EVENT_FLAG_AND(EVENT_FLAG_ROW_AT(pFlag, rowNum, pEcb, row, col), ~((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col));
+        eventMatrix_FlagLeave(pEcb, idx);
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  检查事件标志在当前行数内并取得事件标志矩阵，使能动态行数时进入读取区，
+ *          行数与事件标志矩阵取自同一快照，返回非NULL时须调用 eventMatrix_FlagLeave() 退出
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pRowNum   - 输出事件标志矩阵行数
+ *          pIdx      - 输出读取区引用计数序号
+ *  @return 事件标志矩阵首行指针，NULL为事件标志超出当前行数
+ */
+static EVENT_FLAG_MATRIX_ROW_TYPE *eventMatrix_FlagEnter(pEcb_t pEcb, int eventFlag, int *pRowNum, uint32_t *pIdx) {
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    evDynFlagMatrix_t *pDyn;
+
+    *pIdx = eventMatrix_DynReadLock(pEcb);
+    pDyn  = __atomic_load_n(&pEcb->pDynFlag, __ATOMIC_ACQUIRE);
+    if (eventFlag < 0 || (int)(eventFlag / EVENT_MATRIX_COL) >= pDyn->matrixRow) {
+        eventMatrix_DynReadUnlock(pEcb, *pIdx);
+        return NULL;
+    }
+    *pRowNum = pDyn->matrixRow;
+    return pDyn->flagArr;
+#else
+    *pIdx = 0;
+    if (eventFlag < 0 || (int)(eventFlag / EVENT_MATRIX_COL) >= pEcb->matrixRow) {
+        return NULL;
+    }
+    *pRowNum = pEcb->matrixRow;
+    return *pEcb->pEvFlagMatrix;
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  退出 eventMatrix_FlagEnter() 进入的读取区
+ *  @param  pEcb - 事件控制块指针
+ *          idx  - 读取区引用计数序号
+ *  @return void
+ */
+static void eventMatrix_FlagLeave(pEcb_t pEcb, uint32_t idx) {
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_DynReadUnlock(pEcb, idx);
+#else
+    (void)pEcb;
+    (void)idx;
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  轮询一个事件标志矩阵，执行已设置标志的事件处理回调函数
+ *          每行按列从低到高处理，回调函数中设置的本行更高列事件在本次处理
+ *  @param  pEcb     - 事件控制块指针
+ *          pFlagRow - 事件标志矩阵首行指针
+ *  @return true     - 处理后矩阵中仍有使能的事件标志
+ *          false    - 处理后矩阵中无使能的事件标志
+ */
+static bool eventMatrix_FlagMatrixProcess(pEcb_t pEcb, EVENT_FLAG_MATRIX_ROW_TYPE *pFlagRow) {
+    EVENT_FLAG_MATRIX_ROW_TYPE pend, bit;
+    pEventCB_t *ppCb;
+    evParaSlot_t *pPara;
+    int row, col;
+    bool remain = false;
+#if EVENT_STAT_ENABLE
+    uint32_t beginTime;
+#endif
+
+#if EVENT_MATRIX_SPARSE_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+    pEcb->processing = true;                                                                //回调函数执行期间槽位数组及各矩阵不可移动
+#endif
+    for (row = 0; row < pEcb->matrixRow; row++) {
+        pend = EVENT_FLAG_LOAD(pFlagRow[row]) & EVENT_ENABLE_ROW(pEcb, row);                //该行无使能事件则跳过，继续下一行
+
+        while (pend) {
+#if EVENT_RTC_ENABLE
+            if (pEcb->budget == 0) {                                                        //处理预算用尽，剩余事件留待下次
+                break;
+            }
+#endif
+            col = eventMatrix_BitCtz(pend);                                                 //取最低位已设置的事件标志
+            bit = (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col;
+            ppCb = EVENT_CB_PTR(pEcb, row, col);
+#if EVENT_DEPEND_ENABLE
+            if (ppCb != NULL && *ppCb != NULL && eventMatrix_DepBlocked(pEcb, row, col)) {  //生产者事件待处理时本次不处理，保留事件标志
+                ppCb = NULL;
+            }
+#endif
+
+#if EVENT_AFFINITY_ENABLE
+            if (ppCb != NULL && *ppCb != NULL && EVENT_AFFINITY_GET(pEcb, row, col) != EVENT_AFFINITY_ANY) {    //指定分发线程的事件转交其路由队列
+                if (eventMatrix_AffinityRoute(  pEcb->pDispatcherArr[EVENT_AFFINITY_GET(pEcb, row, col) - 1],
+                                                pEcb,
+                                                row * EVENT_MATRIX_COL + col,
+                                                *ppCb,
+                                                EVENT_PARA_PTR(pEcb, row, col))) {
+                    EVENT_FLAG_AND(pFlagRow[row], ~bit);                                    //全部参数转交后清除事件标志，队列满时留待下次事件处理
+#if EVENT_RTC_ENABLE
+                    pEcb->budget--;                                                         //转交失败不计入处理预算，无进展时连续处理停止
+#endif
+                }
+            } else
+#endif
+            if (ppCb != NULL && *ppCb != NULL) {                                            //回调函数存在则执行事件处理回调函数
+                pPara = EVENT_PARA_PTR(pEcb, row, col);
+#if EVENT_RTC_ENABLE
+                pEcb->budget--;
+#endif
+#if EVENT_TRACE_ENABLE
+                eventMatrix_TraceRecord(EV_TRACE_TYPE_DISPATCH, row * EVENT_MATRIX_COL + col, 0);
+#endif
+#if EVENT_STAT_ENABLE
+                beginTime = eventMatrix_StatBegin(pEcb, row * EVENT_MATRIX_COL + col);
+#endif
+#if EVENT_PARA_QUEUE_ENABLE
+                if (eventMatrix_ParaQueueDispatch(pEcb, *ppCb, pPara)) {                          //参数队列处理完毕才清除事件标志
+                    EVENT_FLAG_AND(pFlagRow[row], ~bit);
+                }
+#else
+                (*ppCb)(*pPara);
+
+                if (*pPara != NULL) {                                                       //检查参数集合数据结构内存是否释放，未释放则进行释放
+                    EVENT_PARA_FREE(&pEcb->reclaim, *pPara);
+                    *pPara = NULL;
+                }
+                EVENT_FLAG_AND(pFlagRow[row], ~bit);                                        //清除事件标志
+#endif
+#if EVENT_STAT_ENABLE
+                eventMatrix_StatEnd(pEcb, row * EVENT_MATRIX_COL + col, beginTime);
+#endif
+            }
+            pend = EVENT_FLAG_LOAD(pFlagRow[row]) & EVENT_ENABLE_ROW(pEcb, row) & ~(bit | (bit - 1));   //重新读取本行高于当前列的事件标志
+        }
+    }
+
+    for (row = 0; row < pEcb->matrixRow && !remain; row++) {                                //回调函数可能设置已轮询行的事件，轮询完成后再检查
+        remain = (EVENT_FLAG_LOAD(pFlagRow[row]) & EVENT_ENABLE_ROW(pEcb, row)) != 0;
+    }
+#if EVENT_RECLAIM_ENABLE
+    eventMatrix_ReclaimFlush(&pEcb->reclaim);                                               //回调函数全部执行后批量释放本遍参数
+#endif
+#if EVENT_MATRIX_SPARSE_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+    pEcb->processing = false;
+#endif
+    return remain;
+}
+
+/*******************************************************************************
+ *  @brief  事件处理函数，轮询事件矩阵
+ *          使能事件定时器时先推进时间轮
+ *          使能事件优先级时按优先级类从高到低处理，每个优先级类每次最多处理一遍，
+ *          低优先级类回调函数中设置的更高优先级类事件在本次调用中优先处理
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+extern void eventMatrix_EventProcess(pEcb_t pEcb) {
+    if (pEcb == NULL) {
+        return;
+    }
+
+#if EVENT_TRACE_ENABLE
+    eventMatrix_TraceRecord(EV_TRACE_TYPE_PROCESS, 0, 0);
+#endif
+#if EVENT_RTC_ENABLE
+    pEcb->budget = UINT32_MAX;                                                  //单次轮询不限处理次数
+#endif
+    eventMatrix_ProcessPass(pEcb);
+}
+
+/*******************************************************************************
+ *  @brief  事件连续处理函数，反复轮询事件矩阵直至无待处理事件、处理预算用尽或一遍轮询未执行任何回调函数，
+ *          回调函数中设置的已轮询行事件及被依赖推迟的事件在本次调用中处理，无需等待下一轮询周期
+ *  @param  pEcb   - 事件控制块指针
+ *          budget - 本次调用最多执行回调函数次数，0为不限
+ *  @return true   - 已无待处理事件
+ *          false  - 预算用尽，或剩余事件无回调函数、被屏蔽、转交队列满而无法处理
+ */
+#if EVENT_RTC_ENABLE
+extern bool eventMatrix_EventProcessRTC(pEcb_t pEcb, uint32_t budget) {
+    uint32_t last;
+    bool remain;
+
+    if (pEcb == NULL) {
+        return false;
+    }
+
+#if EVENT_TRACE_ENABLE
+    eventMatrix_TraceRecord(EV_TRACE_TYPE_PROCESS, 0, 0);
+#endif
+    pEcb->budget = budget != 0 ? budget : UINT32_MAX;
+    do {
+        last   = pEcb->budget;
+        remain = eventMatrix_ProcessPass(pEcb);
+    } while (remain && pEcb->budget != 0 && pEcb->budget != last);              //无进展时停止，避免空转
+
+    pEcb->budget = UINT32_MAX;
+    return !remain;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  轮询事件矩阵前的准备，使能事件定时器时推进时间轮，使能分片时合并分片
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+static void eventMatrix_ProcessPrepare(pEcb_t pEcb) {
+#if EVENT_SHARD_ENABLE
+    evShardId = EVENT_SHARD_ID_DIRECT;                                          //事件处理线程、到期定时器及回调函数直接写事件标志矩阵，不占用分片
+#endif
+#if EVENT_TIMER_ENABLE
+    eventMatrix_TimerAdvance(pEcb);                                             //推进时间轮，到期定时器设置事件标志
+#endif
+#if EVENT_SHARD_ENABLE
+    eventMatrix_ShardMerge(pEcb);
+#endif
+    (void)pEcb;                                                                 //定时器及分片均未使能时不使用
+}
+
+/*******************************************************************************
+ *  @brief  轮询一遍事件矩阵，轮询前推进时间轮并合并分片
+ *  @param  pEcb  - 事件控制块指针
+ *  @return true  - 处理后仍可能有待处理事件
+ *          false - 无待处理事件
+ */
+static bool eventMatrix_ProcessPass(pEcb_t pEcb) {
+#if EVENT_PRIORITY_ENABLE
+    uint32_t doneMask = 0, pendMask;
+#endif
+
+    eventMatrix_ProcessPrepare(pEcb);
+
+#if EVENT_PRIORITY_ENABLE
+    while ((pendMask = pEcb->prioMask & ~doneMask) != 0) {
+        doneMask |= (uint32_t)1 << eventMatrix_PrioClassProcess(pEcb, pendMask);
+    }
+    return pEcb->prioMask != 0;
+#else
+    return eventMatrix_FlagMatrixProcess(pEcb, *pEcb->pEvFlagMatrix);
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  处理待处理掩码中最高优先级类的事件
+ *  @param  pEcb     - 事件控制块指针
+ *          pendMask - 优先级类待处理掩码，不可为0
+ *  @return 本次处理的优先级类
+ */
+#if EVENT_PRIORITY_ENABLE
+static int eventMatrix_PrioClassProcess(pEcb_t pEcb, uint32_t pendMask) {
+    int prio;
+
+#if defined(__GNUC__)
+    prio = 31 - __builtin_clz(pendMask);                                        //取最高置位，O(1)选择优先级类
+#else
+    for (prio = 31; !(pendMask & ((uint32_t)1 << prio)); prio--);
+#endif
+
+    EVENT_FLAG_AND(pEcb->prioMask, ~((uint32_t)1 << prio));                     //先清除，回调函数中设置同类事件时重新置位
+    if (eventMatrix_FlagMatrixProcess(pEcb, &(*pEcb->pEvFlagMatrix)[prio * pEcb->matrixRow])) {
+        EVENT_FLAG_OR(pEcb->prioMask, (uint32_t)1 << prio);
+    }
+    return prio;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件处理函数，仅处理当前最高待处理优先级类事件，用于限制单次轮询时长
+ *          与完整轮询相同，先推进时间轮并合并分片
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+#if EVENT_PRIORITY_ENABLE
+extern void eventMatrix_EventProcessTopClass(pEcb_t pEcb) {
+    if (pEcb == NULL) {
+        return;
+    }
+
+#if EVENT_TRACE_ENABLE
+    eventMatrix_TraceRecord(EV_TRACE_TYPE_PROCESS, 0, 0);
+#endif
+#if EVENT_RTC_ENABLE
+    pEcb->budget = UINT32_MAX;                                                  //单次轮询不限处理次数
+#endif
+    eventMatrix_ProcessPrepare(pEcb);
+    if (pEcb->prioMask != 0) {
+        eventMatrix_PrioClassProcess(pEcb, pEcb->prioMask);
+    }
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  按保存顺序依次以队列中各参数执行事件处理回调函数，并释放参数内存
+ *          回调函数执行期间新保存的参数留待下次事件处理
+ *  @param  pEcb   - 事件控制块指针
+ *          pCb    - 事件处理回调函数指针
+ *          pQueue - 事件参数队列指针
+ *  @return true   - 参数队列已处理完毕
+ *          false  - 参数队列中仍有待处理参数
+ */
+#if EVENT_PARA_QUEUE_ENABLE
+static bool eventMatrix_ParaQueueDispatch(pEcb_t pEcb, pEventCB_t pCb, evParaQueue_t *pQueue) {
+    uint32_t i, num = pQueue->count;
+#if EVENT_OCCUR_COUNT_ENABLE
+    uint32_t occurTimes = EVENT_COUNT_LOAD(pQueue->occurTimes);                 //本次处理的事件发生次数，回调函数中可读取
+#else
+    uint32_t occurTimes = 0;
+#endif
+#if !EVENT_RECLAIM_ENABLE
+    (void)pEcb;                                                                 //未使能延迟回收时直接释放参数
+#endif
+
+#if EVENT_BATCH_CB_ENABLE
+    if (pQueue->pBatchCb != NULL) {                                             //批量回调函数一次处理全部缓存参数
+        pQueue->pBatchCb(pQueue->pParaBuf, (int)num, occurTimes);
+    } else
+#endif
+    if (num == 0) {                                                             //仅设置了事件标志而未保存参数
+        pCb(NULL);
+    } else {
+        for (i = 0; i < num; i++) {
+            pCb(pQueue->pParaBuf[i]);
+        }
+    }
+
+    for (i = 0; i < num; i++) {
+        if (pQueue->pParaBuf[i] != NULL) {
+            EVENT_PARA_FREE(&pEcb->reclaim, pQueue->pParaBuf[i]);
+            pQueue->pParaBuf[i] = NULL;
+        }
+    }
+
+#if EVENT_OCCUR_COUNT_ENABLE
+    EVENT_COUNT_SUB(pQueue->occurTimes, occurTimes);                            //保留回调函数执行期间新发生的次数
+#else
+    (void)occurTimes;
+#endif
+
+    pQueue->count -= num;
+    if (pQueue->count > 0) {                                                    //回调函数中新保存的参数前移至队首
+        memmove(&pQueue->pParaBuf[0], &pQueue->pParaBuf[num], pQueue->count * sizeof(void *));
+    }
+    return pQueue->count == 0;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件发生次数饱和递增，事件可由其他线程设置时以比较交换保证多线程计数不丢失
+ *  @param  pTimes - 事件发生次数指针
+ *  @return void
+ */
+#if EVENT_OCCUR_COUNT_ENABLE
+static void eventMatrix_OccurInc(uint32_t *pTimes) {
+#if EVENT_WAIT_ENABLE || EVENT_SHARD_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+    uint32_t val = __atomic_load_n(pTimes, __ATOMIC_RELAXED);
+
+    while (val != UINT32_MAX && !__atomic_compare_exchange_n(pTimes, &val, val + 1,
+                                                             true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+    if (*pTimes != UINT32_MAX) {                                                //饱和不溢出
+        (*pTimes)++;
+    }
+#endif
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  保存事件参数集合数据结构指针，以供事件处理回调函数使用
+ *          使能参数队列时参数按保存顺序入队，队列满时保存失败，参数内存仍归调用者所有
+ *          使能稀疏存储时未注册事件无参数存储位置，保存失败
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pPara     - 事件参数集合数据结构指针
+ *  @return true      - 保存成功
+ *          false     - 保存失败
+ */
+#if EVENT_TRACE_ENABLE
+extern bool eventMatrix_SaveEventPara(pEcb_t pEcb, int eventFlag, void *pPara) {
+    return eventMatrix_SaveEventParaSz(pEcb, eventFlag, pPara, 0);
+}
+
+/*******************************************************************************
+ *  @brief  保存事件参数集合数据结构指针，并在跟踪记录中记录参数大小
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pPara     - 事件参数集合数据结构指针
+ *          paraSize  - 事件参数集合数据结构大小
+ *  @return true      - 保存成功
+ *          false     - 保存失败
+ */
+extern bool eventMatrix_SaveEventParaSz(pEcb_t pEcb, int eventFlag, void *pPara, uint32_t paraSize) {
+#else
+extern bool eventMatrix_SaveEventPara(pEcb_t pEcb, int eventFlag, void *pPara) {
+#endif
+    int row, col, rowNum;
+    uint32_t idx;
+    evParaSlot_t *pSlot;
+    bool ret = false;
+
+    if (pEcb == NULL) {
+        return false;
+    }
+
+    row = eventFlag / EVENT_MATRIX_COL;
+    col = eventFlag % EVENT_MATRIX_COL;
+    if (eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx) == NULL) {       //超出当前行数的事件无参数存储位置
+        return false;
+    }
+#if EVENT_TRACE_ENABLE
+    eventMatrix_TraceRecord(EV_TRACE_TYPE_PARA, eventFlag, paraSize);
+#endif
+    pSlot = EVENT_PARA_PTR(pEcb, row, col);
+    if (pSlot == NULL) {
+        goto exit;
+    }
+#if EVENT_PARA_QUEUE_ENABLE
+    if (pSlot->count >= EVENT_PARA_QUEUE_DEPTH) {                               //参数队列已满，丢弃该参数
+#if EVENT_PARA_DROP_COUNT_ENABLE
+        pSlot->dropTimes++;
+#endif
+        goto exit;
+    }
+    pSlot->pParaBuf[pSlot->count++] = pPara;
+#else
+    *pSlot = pPara;
+#endif
+    ret = true;
+
+exit:
+    eventMatrix_FlagLeave(pEcb, idx);
+    return ret;
+}
+
+/*******************************************************************************
+ *  @brief  注册事件处理回调函数
+ *          使能稀疏存储时首次注册分配槽位，事件处理回调函数执行期间不可注册新事件
+ *          使能动态行数时事件标志超出当前行数则扩展矩阵，事件处理回调函数执行期间不可扩展
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pCb       - 事件处理回调函数指针
+ *  @return true      - 注册成功
+ *          false     - 注册失败
+ */
+extern bool eventMatrix_RegistEvCB(pEcb_t pEcb, int eventFlag, pEventCB_t pCb) {
+    int row, col;
+
+    if (pEcb != NULL) {
+        row = eventFlag / EVENT_MATRIX_COL;
+        col = eventFlag % EVENT_MATRIX_COL;
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+        if (eventFlag < 0 || !eventMatrix_Resize(pEcb, row + 1)) {              //按注册的最大事件标志扩展行数
+            return false;
+        }
+#endif
+#if EVENT_MATRIX_SPARSE_ENABLE
+        if (eventMatrix_SparseSlot(pEcb, row, col) == NULL) {
+            if (pCb == NULL) {                                                  //注销未注册事件无需分配槽位
+                return true;
+            }
+            if (eventMatrix_SparseSlotAlloc(pEcb, row, col) == NULL) {
+                return false;
+            }
+        }
+#endif
+        *EVENT_CB_PTR(pEcb, row, col) = pCb;
+#if EVENT_BATCH_CB_ENABLE
+        EVENT_PARA_PTR(pEcb, row, col)->pBatchCb = NULL;
+#endif
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  注册事件处理回调函数并指定事件优先级类，事件标志已设置时随之移入新优先级类
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pCb       - 事件处理回调函数指针
+ *          prio      - 事件优先级类，0 ~ EVENT_PRIORITY_CLASS_NUM - 1，数值越大优先级越高
+ *  @return true      - 注册成功
+ *          false     - 注册失败
+ */
+#if EVENT_PRIORITY_ENABLE
+extern bool eventMatrix_RegistEvCBPrio(pEcb_t pEcb, int eventFlag, pEventCB_t pCb, int prio) {
+    int row, col;
+    bool set;
+
+    if (pEcb != NULL && pEcb->pEvPrioMatrix != NULL && prio >= 0 && prio < EVENT_PRIORITY_CLASS_NUM) {
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+        if (eventFlag < 0 || !eventMatrix_Resize(pEcb, eventFlag / EVENT_MATRIX_COL + 1)) {
+            return false;
+        }
+#endif
+        row = eventFlag / EVENT_MATRIX_COL;
+        col = eventFlag % EVENT_MATRIX_COL;
+        set = eventMatrix_GetEventFlag(pEcb, eventFlag);
+
+        eventMatrix_ClearEventFlag(pEcb, eventFlag);
+        (*pEcb->pEvPrioMatrix)[row][col] = (uint8_t)prio;
+        if (set) {
+            EVENT_FLAG_OR(EVENT_FLAG_ROW(pEcb, row, col), (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col);
+            EVENT_FLAG_OR(pEcb->prioMask, (uint32_t)1 << prio);
+        }
+        return eventMatrix_RegistEvCB(pEcb, eventFlag, pCb);
+    }
+    return false;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  注册事件处理回调函数并指定事件分发线程，事件处理时该事件的回调函数转交分发线程执行
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pCb       - 事件处理回调函数指针
+ *          affinity  - 分发线程序号+1，即 eventMatrix_ecbAffinityInit() 中分发线程数组下标+1，
+ *                      EVENT_AFFINITY_ANY 为在调用事件处理函数的线程中执行
+ *  @return true      - 注册成功
+ *          false     - 注册失败
+ */
+#if EVENT_AFFINITY_ENABLE
+extern bool eventMatrix_RegistEvCBAffinity(pEcb_t pEcb, int eventFlag, pEventCB_t pCb, int affinity) {
+    if (pEcb != NULL && pEcb->pEvAffinityMatrix != NULL && affinity >= EVENT_AFFINITY_ANY && affinity <= pEcb->dispatcherNum &&
+        eventMatrix_RegistEvCB(pEcb, eventFlag, pCb)) {
+        (*pEcb->pEvAffinityMatrix)[eventFlag / EVENT_MATRIX_COL][eventFlag % EVENT_MATRIX_COL] = (uint8_t)affinity;
+        return true;
+    }
+    return false;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件统计初始化，统计信息表按事件标志索引，未覆盖的事件不统计
+ *  @param  pEcb         - 事件控制块指针
+ *          pEvStatTable - 事件统计信息表指针
+ *          statNum      - 事件统计信息表长度
+ *          pGetTime     - 统计时间读取函数指针，如微秒计数器或CPU周期计数器
+ *  @return true         - 初始化成功
+ *          false        - 初始化失败
+ */
+#if EVENT_STAT_ENABLE
+extern bool eventMatrix_StatInit(pEcb_t pEcb, pEvStat_t pEvStatTable, int statNum, pEvGetTick_t pGetTime) {
+    if (pEcb == NULL || pEvStatTable == NULL || statNum <= 0 || pGetTime == NULL) {
+        return false;
+    }
+
+    memset(pEvStatTable, 0, statNum * sizeof(evStat_t));
+    pEcb->pStatGetTime  =   pGetTime;
+    pEcb->statNum       =   statNum;
+    pEcb->pEvStatTable  =   pEvStatTable;
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  读取事件统计信息快照
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pStat     - 统计信息存储指针
+ *  @return true      - 读取成功
+ *          false     - 读取失败
+ */
+extern bool eventMatrix_StatSnapshot(pEcb_t pEcb, int eventFlag, pEvStat_t pStat) {
+    if (pEcb == NULL || pEcb->pEvStatTable == NULL || pStat == NULL ||
+        eventFlag < 0 || eventFlag >= pEcb->statNum) {
+        return false;
+    }
+
+    *pStat = pEcb->pEvStatTable[eventFlag];
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  清零全部事件统计信息
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+extern void eventMatrix_StatReset(pEcb_t pEcb) {
+    if (pEcb != NULL && pEcb->pEvStatTable != NULL) {
+        memset(pEcb->pEvStatTable, 0, pEcb->statNum * sizeof(evStat_t));
+    }
+}
+
+/*******************************************************************************
+ *  @brief  记录事件标志设置时间
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *  @return void
+ */
+static void eventMatrix_StatPost(pEcb_t pEcb, int eventFlag) {
+    if (pEcb->pEvStatTable != NULL && eventFlag >= 0 && eventFlag < pEcb->statNum) {
+        pEcb->pEvStatTable[eventFlag].postTime = pEcb->pStatGetTime();
+    }
+}
+
+/*******************************************************************************
+ *  @brief  事件分发开始，统计设置至分发延时
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *  @return 分发开始时间
+ */
+static uint32_t eventMatrix_StatBegin(pEcb_t pEcb, int eventFlag) {
+    pEvStat_t   pStat;
+    uint32_t    now, latency;
+
+    if (pEcb->pEvStatTable == NULL || eventFlag >= pEcb->statNum) {
+        return 0;
+    }
+
+    pStat = &pEcb->pEvStatTable[eventFlag];
+    now = pEcb->pStatGetTime();
+    latency = now - pStat->postTime;
+
+    pStat->latencySum += latency;
+    if (latency > pStat->latencyMax) {
+        pStat->latencyMax = latency;
+    }
+    return now;
+}
+
+/*******************************************************************************
+ *  @brief  事件分发结束，统计分发次数及回调函数执行时长
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          beginTime - 分发开始时间
+ *  @return void
+ */
+static void eventMatrix_StatEnd(pEcb_t pEcb, int eventFlag, uint32_t beginTime) {
+    pEvStat_t   pStat;
+    uint32_t    now, duration;
+    int         bin;
+
+    if (pEcb->pEvStatTable == NULL || eventFlag >= pEcb->statNum) {
+        return;
+    }
+
+    pStat = &pEcb->pEvStatTable[eventFlag];
+    now = pEcb->pStatGetTime();
+    duration = now - beginTime;
+
+#if defined(__GNUC__)
+    bin = duration == 0 ? 0 : 32 - __builtin_clz(duration);                     //按时长二进制位数分区间
+#else
+    for (bin = 0; bin < 32 && (duration >> bin) != 0; bin++);
+#endif
+    if (bin >= EVENT_STAT_HIST_BINS) {
+        bin = EVENT_STAT_HIST_BINS - 1;
+    }
+
+    pStat->durationHist[bin]++;
+    pStat->dispatchTimes++;
+    if (duration > pStat->durationMax) {
+        pStat->durationMax = duration;
+    }
+    pStat->postTime = now;                                                      //事件仍待处理时，下次延时自本次分发结束计
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件标志分片初始化，分片按线程分配，线程首次设置事件标志时自动分配分片序号，
+ *          线程数超过分片数时超出的线程直接以原子操作写事件标志矩阵
+ *  @param  pEcb         - 事件控制块指针
+ *          pShardHead   - 事件标志分片头数组指针
+ *          pShardFlag   - 事件标志分片数组指针，按缓存行对齐
+ *          shardNum     - 分片数
+ *          shardRowSize - 每个分片行数，EVENT_SHARD_ROW_SIZE(matrixRow)
+ *  @return true         - 初始化成功
+ *          false        - 初始化失败
+ */
+#if EVENT_SHARD_ENABLE
+extern bool eventMatrix_ShardInit(  pEcb_t                      pEcb,
+                                    evShardHead_t               *pShardHead,
+                                    EVENT_FLAG_MATRIX_ROW_TYPE  *pShardFlag,
+                                    int                         shardNum,
+                                    int                         shardRowSize)
+{
+    if (pEcb == NULL || pShardHead == NULL || pShardFlag == NULL || shardNum <= 0 || shardRowSize < pEcb->matrixRow) {
+        return false;
+    }
+
+    memset(pShardHead, 0, shardNum * sizeof(evShardHead_t));
+    memset(pShardFlag, 0, shardNum * shardRowSize * sizeof(EVENT_FLAG_MATRIX_ROW_TYPE));
+    pEcb->pShardHead        =   pShardHead;
+    pEcb->pShardFlag        =   pShardFlag;
+    pEcb->shardRowSize      =   shardRowSize;
+    __atomic_store_n(&pEcb->shardNum, shardNum, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  绑定本线程使用的分片，线程池等线程反复创建的场合应显式绑定，避免自动分配的序号耗尽
+ *  @param  shardId - 分片序号，-1为不使用分片
+ *  @return void
+ */
+extern void eventMatrix_ShardBind(int shardId) {
+    evShardId = shardId < 0 ? EVENT_SHARD_ID_DIRECT : shardId;
+}
+
+/*******************************************************************************
+ *  @brief  获取本线程分片，线程首次使用时自动分配分片序号
+ *  @param  pEcb   - 事件控制块指针
+ *          ppHead - 输出本线程分片头指针
+ *  @return 本线程分片事件标志行数组指针，NULL为本线程无可用分片
+ */
+static EVENT_FLAG_MATRIX_ROW_TYPE *eventMatrix_ShardGet(pEcb_t pEcb, evShardHead_t **ppHead) {
+    int id = evShardId;
+
+    if (id == EVENT_SHARD_ID_NONE) {
+        id = __atomic_fetch_add(&evShardNext, 1, __ATOMIC_RELAXED);
+        evShardId = id;
+    }
+    if (id < 0 || id >= __atomic_load_n(&pEcb->shardNum, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+
+    *ppHead = &pEcb->pShardHead[id];
+    return &pEcb->pShardFlag[id * pEcb->shardRowSize];
+}
+
+/*******************************************************************************
+ *  @brief  标记分片待合并，须在写入分片行之后调用
+ *  @param  pHead - 分片头指针
+ *  @return void
+ */
+static void eventMatrix_ShardMark(evShardHead_t *pHead) {
+    if (!__atomic_load_n(&pHead->dirty, __ATOMIC_SEQ_CST)) {                   //已标记则不再写分片头，避免与合并线程争用
+        __atomic_store_n(&pHead->dirty, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+/*******************************************************************************
+ *  @brief  合并各分片事件标志至事件标志矩阵，分片标记先于分片行交换清除，
+ *          合并期间新设置的标志或在本次合并，或重新标记分片留待下次合并
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+static void eventMatrix_ShardMerge(pEcb_t pEcb) {
+    EVENT_FLAG_MATRIX_ROW_TYPE *pFlag, bits;
+    int id, row, shardNum = __atomic_load_n(&pEcb->shardNum, __ATOMIC_ACQUIRE);
+#if EVENT_PRIORITY_ENABLE
+    int col;
+#endif
+
+    for (id = 0; id < shardNum; id++) {
+        if (!__atomic_load_n(&pEcb->pShardHead[id].dirty, __ATOMIC_RELAXED) ||
+            !__atomic_exchange_n(&pEcb->pShardHead[id].dirty, 0, __ATOMIC_SEQ_CST)) {
+            continue;
+        }
+
+        pFlag = &pEcb->pShardFlag[id * pEcb->shardRowSize];
+        for (row = 0; row < pEcb->matrixRow; row++) {
+            if (!__atomic_load_n(&pFlag[row], __ATOMIC_RELAXED)) {
+                continue;
+            }
+            bits = __atomic_exchange_n(&pFlag[row], 0, __ATOMIC_SEQ_CST);
+#if EVENT_PRIORITY_ENABLE
+            for (; bits; bits &= bits - 1) {                                    //按事件所在优先级类合并
+                col = eventMatrix_BitCtz(bits);
+                EVENT_FLAG_OR(EVENT_FLAG_ROW(pEcb, row, col), (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col);
+                EVENT_FLAG_OR(pEcb->prioMask, (uint32_t)1 << EVENT_PRIO_GET(pEcb, row, col));
+            }
+#else
+            EVENT_FLAG_OR((*pEcb->pEvFlagMatrix)[row], bits);
+#endif
+        }
+    }
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件等待初始化，创建唤醒文件描述符
+ *          使能事件等待后事件标志可由其他线程设置，参数保存及事件处理仍须在事件处理线程中进行
+ *  @param  pEcb  - 事件控制块指针
+ *  @return true  - 初始化成功
+ *          false - 初始化失败
+ */
+#if EVENT_WAIT_ENABLE
+extern bool eventMatrix_WaitInit(pEcb_t pEcb) {
+    if (pEcb == NULL) {
+        return false;
+    }
+
+    pEcb->waitFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return pEcb->waitFd >= 0;
+}
+
+/*******************************************************************************
+ *  @brief  事件等待去初始化，关闭唤醒文件描述符
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+extern void eventMatrix_WaitDeinit(pEcb_t pEcb) {
+    if (pEcb != NULL && pEcb->waitFd >= 0) {
+        close(pEcb->waitFd);
+        pEcb->waitFd = -1;
+    }
+}
+
+/*******************************************************************************
+ *  @brief  读取唤醒文件描述符，可加入epoll监听可读事件，使用方法：
+ *          if (eventMatrix_WaitPrepare(pEcb)) { epoll_wait(...); }
+ *          eventMatrix_WaitFinish(pEcb);
+ *          eventMatrix_EventProcess(pEcb);
+ *  @param  pEcb - 事件控制块指针
+ *  @return 文件描述符，-1为未初始化
+ */
+extern int eventMatrix_GetWaitFd(pEcb_t pEcb) {
+    return pEcb != NULL ? pEcb->waitFd : -1;
+}
+
+/*******************************************************************************
+ *  @brief  查看事件标志矩阵是否为空，无回调函数的事件不会被处理，不计入待处理事件
+ *  @param  pEcb  - 事件控制块指针
+ *  @return true  - 无待处理事件
+ *          false - 有待处理事件
+ */
+static bool eventMatrix_IsEmpty(pEcb_t pEcb) {
+    EVENT_FLAG_MATRIX_ROW_TYPE bits;
+    pEventCB_t *ppCb;
+    int prio, row;
+#if EVENT_SHARD_ENABLE
+    int id;
+#endif
+
+#if EVENT_SHARD_ENABLE
+    for (id = 0; id < __atomic_load_n(&pEcb->shardNum, __ATOMIC_ACQUIRE); id++) {
+        if (__atomic_load_n(&pEcb->pShardHead[id].dirty, __ATOMIC_SEQ_CST)) {   //分片中有未合并的事件标志
+            return false;
+        }
+    }
+#endif
+#if EVENT_PRIORITY_ENABLE
+    if (__atomic_load_n(&pEcb->prioMask, __ATOMIC_SEQ_CST) == 0) {
+        return true;
+    }
+#endif
+    for (prio = 0; prio < EVENT_FLAG_OBJ_ROW(1); prio++) {
+        for (row = 0; row < pEcb->matrixRow; row++) {
+            bits = __atomic_load_n(&(*pEcb->pEvFlagMatrix)[prio * pEcb->matrixRow + row], __ATOMIC_SEQ_CST) & EVENT_ENABLE_ROW(pEcb, row);
+            for (; bits; bits &= bits - 1) {
+                ppCb = EVENT_CB_PTR(pEcb, row, eventMatrix_BitCtz(bits));
+                if (ppCb != NULL && *ppCb != NULL) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  事件处理线程准备睡眠时唤醒事件处理线程，仅第一个设置事件标志者写唤醒文件描述符
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+static void eventMatrix_WakeUp(pEcb_t pEcb) {
+    uint64_t one = 1;
+
+    if (__atomic_load_n(&pEcb->waitArmed, __ATOMIC_SEQ_CST) &&
+        __atomic_exchange_n(&pEcb->waitArmed, 0, __ATOMIC_SEQ_CST)) {
+        if (write(pEcb->waitFd, &one, sizeof(one)) < 0) {
+            return;                                                             //计数已满时文件描述符已可读，无需处理
+        }
+    }
+}
+
+/*******************************************************************************
+ *  @brief  准备睡眠，置位睡眠标志后再检查事件标志矩阵，保证不丢失唤醒
+ *  @param  pEcb  - 事件控制块指针
+ *  @return true  - 无事件待处理，可以睡眠
+ *          false - 已有事件待处理，不可睡眠
+ */
+extern bool eventMatrix_WaitPrepare(pEcb_t pEcb) {
+    if (pEcb == NULL || pEcb->waitFd < 0) {
+        return false;
+    }
+
+    __atomic_store_n(&pEcb->waitArmed, 1, __ATOMIC_SEQ_CST);
+    if (!eventMatrix_IsEmpty(pEcb)) {
+        __atomic_store_n(&pEcb->waitArmed, 0, __ATOMIC_SEQ_CST);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  结束睡眠，清除睡眠标志并读空唤醒文件描述符
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+extern void eventMatrix_WaitFinish(pEcb_t pEcb) {
+    uint64_t cnt;
+
+    if (pEcb == NULL || pEcb->waitFd < 0) {
+        return;
+    }
+
+    __atomic_store_n(&pEcb->waitArmed, 0, __ATOMIC_SEQ_CST);
+    while (read(pEcb->waitFd, &cnt, sizeof(cnt)) > 0);
+}
+
+/*******************************************************************************
+ *  @brief  阻塞等待事件标志
+ *  @param  pEcb      - 事件控制块指针
+ *          timeoutMs - 超时时间，单位ms，-1为一直等待
+ *  @return true      - 有事件待处理
+ *          false     - 等待超时或失败
+ */
+extern bool eventMatrix_Wait(pEcb_t pEcb, int timeoutMs) {
+    struct pollfd pfd;
+
+    if (pEcb == NULL || pEcb->waitFd < 0) {
+        return false;
+    }
+
+    if (eventMatrix_WaitPrepare(pEcb)) {
+        pfd.fd      = pEcb->waitFd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        poll(&pfd, 1, timeoutMs);
+    }
+    eventMatrix_WaitFinish(pEcb);
+
+    return !eventMatrix_IsEmpty(pEcb);
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  使能事件参数延迟回收，回调函数执行后参数放入事件处理线程回收列表，
+ *          一遍事件处理结束时批量释放，或提交后台回收线程释放，须在事件处理线程中调用
+ *  @param  pEcb       - 事件控制块指针
+ *          pReclaimer - 后台回收线程指针，须已调用 eventMatrix_ReclaimerStart()，NULL为在事件处理线程中批量释放
+ *  @return true       - 使能成功
+ *          false      - 使能失败
+ */
+#if EVENT_RECLAIM_ENABLE
+extern bool eventMatrix_ecbReclaimInit(pEcb_t pEcb, pEvReclaimer_t pReclaimer) {
+    if (pEcb == NULL) {
+        return false;
+    }
+
+    eventMatrix_ReclaimFlush(&pEcb->reclaim);
+    eventMatrix_ReclaimInit(&pEcb->reclaim, true, pReclaimer);
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  使能事件分发线程参数延迟回收，须在分发线程中调用
+ *  @param  pDisp      - 事件分发线程指针
+ *          pReclaimer - 后台回收线程指针，NULL为在分发线程中批量释放
+ *  @return true       - 使能成功
+ *          false      - 使能失败
+ */
+#if EVENT_AFFINITY_ENABLE
+extern bool eventMatrix_DispatcherReclaimInit(pEvDispatcher_t pDisp, pEvReclaimer_t pReclaimer) {
+    if (pDisp == NULL) {
+        return false;
+    }
+
+    eventMatrix_ReclaimFlush(&pDisp->reclaim);
+    eventMatrix_ReclaimInit(&pDisp->reclaim, true, pReclaimer);
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  创建后台回收线程，多个事件处理线程及分发线程可共用
+ *  @param  pReclaimer - 后台回收线程指针
+ *  @return true       - 创建成功
+ *          false      - 创建失败
+ */
+extern bool eventMatrix_ReclaimerStart(pEvReclaimer_t pReclaimer) {
+    if (pReclaimer == NULL) {
+        return false;
+    }
+
+    pReclaimer->run         =   true;
+    pReclaimer->cur         =   0;
+    pReclaimer->num         =   0;
+    pReclaimer->fullTimes   =   0;
+    if (pthread_mutex_init(&pReclaimer->lock, NULL) != 0) {
+        return false;
+    }
+    if (pthread_cond_init(&pReclaimer->cond, NULL) != 0) {
+        pthread_mutex_destroy(&pReclaimer->lock);
+        return false;
+    }
+    if (pthread_create(&pReclaimer->thread, NULL, eventMatrix_ReclaimerThread, pReclaimer) != 0) {
+        pthread_cond_destroy(&pReclaimer->cond);
+        pthread_mutex_destroy(&pReclaimer->lock);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  停止后台回收线程，释放已提交的全部参数，须在各使用该回收线程的事件处理线程停止后调用
+ *  @param  pReclaimer - 后台回收线程指针
+ *  @return void
+ */
+extern void eventMatrix_ReclaimerStop(pEvReclaimer_t pReclaimer) {
+    if (pReclaimer == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pReclaimer->lock);
+    pReclaimer->run = false;
+    pthread_cond_signal(&pReclaimer->cond);
+    pthread_mutex_unlock(&pReclaimer->lock);
+    pthread_join(pReclaimer->thread, NULL);                                     //回收线程退出前释放剩余参数
+    pthread_cond_destroy(&pReclaimer->cond);
+    pthread_mutex_destroy(&pReclaimer->lock);
+}
+
+/*******************************************************************************
+ *  @brief  参数回收列表初始化
+ *  @param  pReclaim   - 参数回收列表指针
+ *          enable     - 延迟回收使能
+ *          pReclaimer - 后台回收线程指针
+ *  @return void
+ */
+static void eventMatrix_ReclaimInit(evReclaim_t *pReclaim, bool enable, pEvReclaimer_t pReclaimer) {
+    pReclaim->enable        =   enable;
+    pReclaim->num           =   0;
+    pReclaim->pReclaimer    =   pReclaimer;
+}
+
+/*******************************************************************************
+ *  @brief  释放回调函数执行后的参数，使能延迟回收时放入回收列表，列表满时先批量释放
+ *  @param  pReclaim - 参数回收列表指针
+ *          pPara    - 参数指针
+ *  @return void
+ */
+static void eventMatrix_ReclaimPut(evReclaim_t *pReclaim, void *pPara) {
+    if (!pReclaim->enable) {
+        free(pPara);
+        return;
+    }
+    if (pReclaim->num >= EVENT_RECLAIM_BATCH) {
+        eventMatrix_ReclaimFlush(pReclaim);
+    }
+    pReclaim->pParaArr[pReclaim->num++] = pPara;
+}
+
+/*******************************************************************************
+ *  @brief  批量释放回收列表中的参数，有后台回收线程时一次加锁提交全部参数，
+ *          回收线程待释放数组容纳不下的参数在本线程释放
+ *  @param  pReclaim - 参数回收列表指针
+ *  @return void
+ */
+static void eventMatrix_ReclaimFlush(evReclaim_t *pReclaim) {
+    pEvReclaimer_t pReclaimer = pReclaim->pReclaimer;
+    uint32_t i = 0, num;
+
+    if (pReclaim->num == 0) {
+        return;
+    }
+
+    if (pReclaimer != NULL) {
+        pthread_mutex_lock(&pReclaimer->lock);
+        num = EVENT_RECLAIMER_SIZE - pReclaimer->num;
+        if (num >= pReclaim->num) {
+            num = pReclaim->num;
+        } else {
+            pReclaimer->fullTimes++;
+        }
+        memcpy(&pReclaimer->pParaArr[pReclaimer->cur][pReclaimer->num], pReclaim->pParaArr, num * sizeof(void *));
+        pReclaimer->num += num;
+        pthread_cond_signal(&pReclaimer->cond);
+        pthread_mutex_unlock(&pReclaimer->lock);
+        i = num;
+    }
+    for (; i < pReclaim->num; i++) {
+        free(pReclaim->pParaArr[i]);
+    }
+    pReclaim->num = 0;
+}
+
+/*******************************************************************************
+ *  @brief  后台回收线程，取走当前待释放数组并切换提交数组后在锁外批量释放
+ *  @param  pArg - 后台回收线程指针
+ *  @return NULL
+ */
+static void *eventMatrix_ReclaimerThread(void *pArg) {
+    pEvReclaimer_t pReclaimer = (pEvReclaimer_t)pArg;
+    void **pParaArr;
+    uint32_t i, num;
+
+    pthread_mutex_lock(&pReclaimer->lock);
+    for (;;) {
+        while (pReclaimer->num == 0 && pReclaimer->run) {
+            pthread_cond_wait(&pReclaimer->cond, &pReclaimer->lock);
+        }
+        if (pReclaimer->num == 0) {                                             //已停止且无剩余参数
+            break;
+        }
+        pParaArr = pReclaimer->pParaArr[pReclaimer->cur];
+        num = pReclaimer->num;
+        pReclaimer->cur ^= 1;
+        pReclaimer->num = 0;
+        pthread_mutex_unlock(&pReclaimer->lock);
+
+        for (i = 0; i < num; i++) {
+            free(pParaArr[i]);
+        }
+        pthread_mutex_lock(&pReclaimer->lock);
+    }
+    pthread_mutex_unlock(&pReclaimer->lock);
+    return NULL;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  事件分发线程初始化，创建唤醒文件描述符
+ *          分发线程循环调用 eventMatrix_DispatcherWait() 及 eventMatrix_DispatcherProcess()，
+ *          指定该分发线程的事件回调函数仅在该线程中执行
+ *  @param  pDisp - 事件分发线程指针
+ *          pName - 分发线程名称，仅用于识别
+ *  @return true  - 初始化成功
+ *          false - 初始化失败
+ */
+#if EVENT_AFFINITY_ENABLE
+extern bool eventMatrix_DispatcherInit(pEvDispatcher_t pDisp, const char *pName) {
+    uint32_t i;
+
+    if (pDisp == NULL) {
+        return false;
+    }
+
+    for (i = 0; i < EVENT_AFFINITY_QUEUE_SIZE; i++) {
+        pDisp->cellArr[i].seq   =   i;
+        pDisp->cellArr[i].pCb   =   NULL;
+        pDisp->cellArr[i].pPara =   NULL;
+    }
+    pDisp->enqPos       =   0;
+    pDisp->fullTimes    =   0;
+    pDisp->deqPos       =   0;
+    pDisp->waitArmed    =   0;
+    pDisp->pName        =   pName;
+#if EVENT_RECLAIM_ENABLE
+    eventMatrix_ReclaimInit(&pDisp->reclaim, false, NULL);
+#endif
+    pDisp->wakeFd       =   eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    return pDisp->wakeFd >= 0;
+}
+
+/*******************************************************************************
+ *  @brief  事件分发线程去初始化，关闭唤醒文件描述符，路由队列中未执行的参数内存被释放
+ *  @param  pDisp - 事件分发线程指针
+ *  @return void
+ */
+extern void eventMatrix_DispatcherDeinit(pEvDispatcher_t pDisp) {
+    evRouteCell_t *pCell;
+
+    if (pDisp == NULL) {
+        return;
+    }
+
+    while (!eventMatrix_RouteIsEmpty(pDisp)) {
+        pCell = &pDisp->cellArr[pDisp->deqPos & (EVENT_AFFINITY_QUEUE_SIZE - 1)];
+        free(pCell->pPara);
+        __atomic_store_n(&pCell->seq, pDisp->deqPos + EVENT_AFFINITY_QUEUE_SIZE, __ATOMIC_RELEASE);
+        pDisp->deqPos++;
+    }
+    if (pDisp->wakeFd >= 0) {
+        close(pDisp->wakeFd);
+        pDisp->wakeFd = -1;
+    }
+}
+
+/*******************************************************************************
+ *  @brief  读取事件分发线程唤醒文件描述符，可加入epoll监听可读事件，可读后调用
+ *          eventMatrix_DispatcherWait(pDisp, 0) 读空后再调用 eventMatrix_DispatcherProcess()
+ *  @param  pDisp - 事件分发线程指针
+ *  @return 文件描述符，-1为未初始化
+ */
+extern int eventMatrix_DispatcherGetFd(pEvDispatcher_t pDisp) {
+    return pDisp != NULL ? pDisp->wakeFd : -1;
+}
+
+/*******************************************************************************
+ *  @brief  执行路由队列中的事件回调函数并释放参数内存，须在分发线程中调用
+ *          每次最多执行一个队列容量的回调函数，执行期间新转交的事件可能留待下次调用
+ *  @param  pDisp - 事件分发线程指针
+ *  @return 执行回调函数个数
+ */
+extern int eventMatrix_DispatcherProcess(pEvDispatcher_t pDisp) {
+    evRouteCell_t *pCell;
+    pEventCB_t pCb;
+    void *pPara;
+    int num;
+#if EVENT_STAT_ENABLE
+    pEcb_t pEcb;
+    int eventFlag;
+    uint32_t beginTime;
+#endif
+
+    if (pDisp == NULL) {
+        return 0;
+    }
+
+    for (num = 0; num < EVENT_AFFINITY_QUEUE_SIZE && !eventMatrix_RouteIsEmpty(pDisp); num++) {
+        pCell = &pDisp->cellArr[pDisp->deqPos & (EVENT_AFFINITY_QUEUE_SIZE - 1)];
+        pCb   = pCell->pCb;
+        pPara = pCell->pPara;
+#if EVENT_STAT_ENABLE
+        pEcb      = pCell->pEcb;
+        eventFlag = pCell->eventFlag;
+#endif
+        __atomic_store_n(&pCell->seq, pDisp->deqPos + EVENT_AFFINITY_QUEUE_SIZE, __ATOMIC_RELEASE);    //先释放单元，回调函数执行期间生产者可继续入队
+        pDisp->deqPos++;
+
+#if EVENT_STAT_ENABLE
+        beginTime = eventMatrix_StatBegin(pEcb, eventFlag);                     //转交的事件在分发线程中统计，每个参数计一次分发
+#endif
+        pCb(pPara);
+#if EVENT_STAT_ENABLE
+        eventMatrix_StatEnd(pEcb, eventFlag, beginTime);
+#endif
+        if (pPara != NULL) {
+            EVENT_PARA_FREE(&pDisp->reclaim, pPara);
+        }
+    }
+#if EVENT_RECLAIM_ENABLE
+    eventMatrix_ReclaimFlush(&pDisp->reclaim);
+#endif
+    return num;
+}
+
+/*******************************************************************************
+ *  @brief  阻塞等待路由队列非空，置位睡眠标志后再检查队列，保证不丢失唤醒
+ *  @param  pDisp     - 事件分发线程指针
+ *          timeoutMs - 超时时间，单位ms，-1为一直等待，0为仅读空唤醒文件描述符
+ *  @return true      - 有事件待执行
+ *          false     - 等待超时或失败
+ */
+extern bool eventMatrix_DispatcherWait(pEvDispatcher_t pDisp, int timeoutMs) {
+    struct pollfd pfd;
+    uint64_t cnt;
+
+    if (pDisp == NULL || pDisp->wakeFd < 0) {
+        return false;
+    }
+
+    __atomic_store_n(&pDisp->waitArmed, 1, __ATOMIC_SEQ_CST);
+    if (timeoutMs != 0 && eventMatrix_RouteIsEmpty(pDisp)) {
+        pfd.fd      = pDisp->wakeFd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        poll(&pfd, 1, timeoutMs);
+    }
+    __atomic_store_n(&pDisp->waitArmed, 0, __ATOMIC_SEQ_CST);
+    while (read(pDisp->wakeFd, &cnt, sizeof(cnt)) > 0);
+
+    return !eventMatrix_RouteIsEmpty(pDisp);
+}
+
+/*******************************************************************************
+ *  @brief  将事件回调函数及全部缓存参数转交分发线程，参数内存归分发线程所有
+ *  @param  pDisp     - 事件分发线程指针
+ *          pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pCb       - 事件处理回调函数指针
+ *          pPara     - 事件参数存储位置指针
+ *  @return true      - 全部转交
+ *          false     - 路由队列满，未转交的参数保留，留待下次事件处理
+ */
+static bool eventMatrix_AffinityRoute(pEvDispatcher_t pDisp, pEcb_t pEcb, int eventFlag, pEventCB_t pCb, evParaSlot_t *pPara) {
+    uint64_t one = 1;
+    bool done = true;
+#if EVENT_PARA_QUEUE_ENABLE
+    uint32_t num;
+#if EVENT_OCCUR_COUNT_ENABLE
+    uint32_t occurTimes = EVENT_COUNT_LOAD(pPara->occurTimes);                  //本次转交的事件发生次数
+#endif
+
+    if (pPara->count == 0) {                                                    //仅设置了事件标志而未保存参数
+        done = eventMatrix_RoutePush(pDisp, pEcb, eventFlag, pCb, NULL);
+    } else {
+        for (num = 0; num < pPara->count && eventMatrix_RoutePush(pDisp, pEcb, eventFlag, pCb, pPara->pParaBuf[num]); num++);
+        pPara->count -= num;
+        memmove(&pPara->pParaBuf[0], &pPara->pParaBuf[num], pPara->count * sizeof(void *));
+        memset(&pPara->pParaBuf[pPara->count], 0, num * sizeof(void *));
+        done = pPara->count == 0;
+    }
+#if EVENT_OCCUR_COUNT_ENABLE
+    if (done) {
+        EVENT_COUNT_SUB(pPara->occurTimes, occurTimes);                         //保留转交期间新发生的次数
+    }
+#endif
+#else
+    if (eventMatrix_RoutePush(pDisp, pEcb, eventFlag, pCb, *pPara)) {
+        *pPara = NULL;
+    } else {
+        done = false;
+    }
+#endif
+
+    if (!done) {
+        __atomic_fetch_add(&pDisp->fullTimes, 1, __ATOMIC_RELAXED);
+    }
+    if (__atomic_load_n(&pDisp->waitArmed, __ATOMIC_SEQ_CST) &&                 //分发线程准备睡眠时唤醒
+        __atomic_exchange_n(&pDisp->waitArmed, 0, __ATOMIC_SEQ_CST)) {
+        if (write(pDisp->wakeFd, &one, sizeof(one)) < 0) {
+            return done;                                                        //计数已满时文件描述符已可读，无需处理
+        }
+    }
+    return done;
+}
+
+/*******************************************************************************
+ *  @brief  路由队列入队，多生产者无锁，按单元序号判断单元是否可写
+ *  @param  pDisp     - 事件分发线程指针
+ *          pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pCb       - 事件处理回调函数指针
+ *          pPara     - 事件参数
+ *  @return true      - 入队成功
+ *          false     - 队列满
+ */
+static bool eventMatrix_RoutePush(pEvDispatcher_t pDisp, pEcb_t pEcb, int eventFlag, pEventCB_t pCb, void *pPara) {
+    evRouteCell_t *pCell;
+    uint32_t pos = __atomic_load_n(&pDisp->enqPos, __ATOMIC_RELAXED);
+    int32_t diff;
+
+    for (;;) {
+        pCell = &pDisp->cellArr[pos & (EVENT_AFFINITY_QUEUE_SIZE - 1)];
+        diff  = (int32_t)(__atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {                                                        //单元可写，竞争入队位置，失败时pos更新为最新入队位置
+            if (__atomic_compare_exchange_n(&pDisp->enqPos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {                                                  //单元尚未被分发线程取出，队列满
+            return false;
+        } else {                                                                //其他生产者已占用该单元
+            pos = __atomic_load_n(&pDisp->enqPos, __ATOMIC_RELAXED);
+        }
+    }
+
+    pCell->pCb   = pCb;
+    pCell->pPara = pPara;
+#if EVENT_STAT_ENABLE
+    pCell->pEcb      = pEcb;
+    pCell->eventFlag = eventFlag;
+#else
+    (void)pEcb;                                                                 //未使能事件统计时不记录事件
+    (void)eventFlag;
+#endif
+    __atomic_store_n(&pCell->seq, pos + 1, __ATOMIC_SEQ_CST);                   //发布单元，与读取睡眠标志构成顺序一致
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  查看路由队列是否为空，仅分发线程调用
+ *  @param  pDisp - 事件分发线程指针
+ *  @return true  - 队列为空
+ *          false - 队列非空
+ */
+static bool eventMatrix_RouteIsEmpty(pEvDispatcher_t pDisp) {
+    evRouteCell_t *pCell = &pDisp->cellArr[pDisp->deqPos & (EVENT_AFFINITY_QUEUE_SIZE - 1)];
+
+    return __atomic_load_n(&pCell->seq, __ATOMIC_SEQ_CST) != pDisp->deqPos + 1;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  读取事件参数队列当前缓存参数个数
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *  @return 参数个数，-1为读取失败
+ */
+#if EVENT_PARA_QUEUE_ENABLE
+extern int eventMatrix_GetParaCount(pEcb_t pEcb, int eventFlag) {
+    evParaSlot_t *pSlot;
+    int val;
+    int rowNum;
+    uint32_t idx;
+
+    if (pEcb == NULL || eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx) == NULL) {
+        return -1;
+    }
+    pSlot = EVENT_PARA_PTR(pEcb, eventFlag / EVENT_MATRIX_COL, eventFlag % EVENT_MATRIX_COL);
+    val   = pSlot != NULL ? (int)pSlot->count : 0;
+    eventMatrix_FlagLeave(pEcb, idx);
+    return val;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  读取事件参数队列丢弃参数次数
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *  @return 丢弃次数
+ */
+#if EVENT_PARA_QUEUE_ENABLE && EVENT_PARA_DROP_COUNT_ENABLE
+extern uint32_t eventMatrix_GetParaDropTimes(pEcb_t pEcb, int eventFlag) {
+    evParaSlot_t *pSlot;
+    uint32_t val;
+    int rowNum;
+    uint32_t idx;
+
+    if (pEcb == NULL || eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx) == NULL) {
+        return 0;
+    }
+    pSlot = EVENT_PARA_PTR(pEcb, eventFlag / EVENT_MATRIX_COL, eventFlag % EVENT_MATRIX_COL);
+    val   = pSlot != NULL ? pSlot->dropTimes : 0;
+    eventMatrix_FlagLeave(pEcb, idx);
+    return val;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  读取事件发生次数，即自上次事件处理以来设置该事件标志的次数
+ *          在事件处理回调函数中调用可获得本次处理合并的事件发生次数
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *  @return 事件发生次数
+ */
+#if EVENT_OCCUR_COUNT_ENABLE
+extern uint32_t eventMatrix_GetOccurTimes(pEcb_t pEcb, int eventFlag) {
+    evParaSlot_t *pSlot;
+    uint32_t val;
+    int rowNum;
+    uint32_t idx;
+
+    if (pEcb == NULL || eventMatrix_FlagEnter(pEcb, eventFlag, &rowNum, &idx) == NULL) {
+        return 0;
+    }
+    pSlot = EVENT_PARA_PTR(pEcb, eventFlag / EVENT_MATRIX_COL, eventFlag % EVENT_MATRIX_COL);
+    val   = pSlot != NULL ? EVENT_COUNT_LOAD(pSlot->occurTimes) : 0;
+    eventMatrix_FlagLeave(pEcb, idx);
+    return val;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  注册批量事件处理回调函数，事件处理时以全部缓存参数数组、参数个数和
+ *          事件发生次数调用一次，回调返回后参数内存统一释放
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          pBatchCb  - 批量事件处理回调函数指针
+ *  @return true      - 注册成功
+ *          false     - 注册失败
+ */
+#if EVENT_BATCH_CB_ENABLE
+extern bool eventMatrix_RegistEvBatchCB(pEcb_t pEcb, int eventFlag, pEventBatchCB_t pBatchCb) {
+    evParaSlot_t *pSlot;
+
+    if (eventMatrix_RegistEvCB(pEcb, eventFlag, pBatchCb != NULL ? eventMatrix_BatchCbStub : NULL)) {
+        pSlot = EVENT_PARA_PTR(pEcb, eventFlag / EVENT_MATRIX_COL, eventFlag % EVENT_MATRIX_COL);
+        if (pSlot != NULL) {
+            pSlot->pBatchCb = pBatchCb;
+        }
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  批量事件处理回调函数在回调函数矩阵中的占位函数，实际处理由参数队列
+ *          中保存的批量事件处理回调函数完成
+ *  @param  pPara - 事件参数指针
+ *  @return void
+ */
+static void eventMatrix_BatchCbStub(void *pPara) {
+    (void)pPara;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  判断事件是否因生产者事件待处理而推迟处理，生产者无回调函数或被屏蔽时不推迟
+ *  @param  pEcb  - 事件控制块指针
+ *          row   - 消费者事件所在行
+ *          col   - 消费者事件所在列
+ *  @return true  - 推迟处理
+ *          false - 可以处理
+ */
+#if EVENT_DEPEND_ENABLE
+static bool eventMatrix_DepBlocked(pEcb_t pEcb, int row, int col) {
+    pEventCB_t *ppCb;
+    int i, consumer, pRow, pCol;
+    EVENT_FLAG_MATRIX_ROW_TYPE pBit;
+
+    if (pEcb->pEvDepMatrix == NULL || !((*pEcb->pEvDepMatrix)[row] & ((EVENT_FLAG_MATRIX_ROW_TYPE)1 << col))) {
+        return false;
+    }
+
+    consumer = row * EVENT_MATRIX_COL + col;
+    for (i = 0; i < pEcb->depNum; i++) {
+        if (pEcb->pDepArr[i].consumer != consumer) {
+            continue;
+        }
+        pRow = pEcb->pDepArr[i].producer / EVENT_MATRIX_COL;
+        pCol = pEcb->pDepArr[i].producer % EVENT_MATRIX_COL;
+        pBit = (EVENT_FLAG_MATRIX_ROW_TYPE)1 << pCol;
+        ppCb = EVENT_CB_PTR(pEcb, pRow, pCol);
+        if ((EVENT_FLAG_ROW(pEcb, pRow, pCol) & EVENT_ENABLE_ROW(pEcb, pRow) & pBit) && ppCb != NULL && *ppCb != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  判断沿事件依赖由 from 事件能否到达 to 事件，依赖表小，逐轮标记可达依赖直至不再变化
+ *  @param  pEcb  - 事件控制块指针
+ *          from  - 起始事件标志
+ *          to    - 目标事件标志
+ *  @return true  - 可达
+ *          false - 不可达
+ */
+static bool eventMatrix_DepReach(pEcb_t pEcb, int from, int to) {
+    pEvDep_t pDep;
+    int i, j;
+    bool changed;
+
+    for (i = 0; i < pEcb->depNum; i++) {
+        pEcb->pDepArr[i].visit = false;
+    }
+
+    do {
+        changed = false;
+        for (i = 0; i < pEcb->depNum; i++) {
+            pDep = &pEcb->pDepArr[i];
+            if (pDep->visit) {
+                continue;
+            }
+            for (j = 0; pDep->producer != from && j < pEcb->depNum; j++) {      //生产者为起始事件或已标记依赖的消费者时可达
+                if (pEcb->pDepArr[j].visit && pEcb->pDepArr[j].consumer == pDep->producer) {
+                    break;
+                }
+            }
+            if (pDep->producer == from || j < pEcb->depNum) {
+                if (pDep->consumer == to) {
+                    return true;
+                }
+                pDep->visit = true;
+                changed = true;
+            }
+        }
+    } while (changed);
+
+    return false;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  读取最低位已设置位的位序
+ *  @param  bits - 位图，不可为0
+ *  @return 位序
+ */
+static int eventMatrix_BitCtz(EVENT_FLAG_MATRIX_ROW_TYPE bits) {
+#if defined(__GNUC__)
+    return __builtin_ctzll((unsigned long long)bits);
+#else
+    int n = 0;
+
+    while (!(bits & 1)) {
+        bits >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  统计位图中已设置位数
+ *  @param  bits - 位图
+ *  @return 位数
+ */
+#if EVENT_MATRIX_SPARSE_ENABLE
+static int eventMatrix_BitCount(EVENT_FLAG_MATRIX_ROW_TYPE bits) {
+#if defined(__GNUC__)
+    return __builtin_popcountll((unsigned long long)bits);
+#else
+    int n = 0;
+
+    for (; bits; bits &= bits - 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  读取稀疏事件矩阵槽位
+ *  @param  pEcb - 事件控制块指针
+ *          row  - 行
+ *          col  - 列
+ *  @return 槽位指针，事件未注册返回NULL
+ */
+static evSlot_t *eventMatrix_SparseSlot(pEcb_t pEcb, int row, int col) {
+    evSparseRow_t *pRow = &(*pEcb->pEvSparseMatrix)[row];
+    EVENT_FLAG_MATRIX_ROW_TYPE bit = (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col;
+
+    if (!(pRow->regMask & bit)) {
+        return NULL;
+    }
+    return &pRow->pSlotArr[eventMatrix_BitCount(pRow->regMask & (bit - 1))];
+}
+
+/*******************************************************************************
+ *  @brief  分配稀疏事件矩阵槽位，槽位数组容量不足时按倍数扩展，新槽位按列顺序插入
+ *  @param  pEcb - 事件控制块指针
+ *          row  - 行
+ *          col  - 列
+ *  @return 槽位指针，事件处理中或内存不足返回NULL
+ */
+static evSlot_t *eventMatrix_SparseSlotAlloc(pEcb_t pEcb, int row, int col) {
+    evSparseRow_t *pRow = &(*pEcb->pEvSparseMatrix)[row];
+    EVENT_FLAG_MATRIX_ROW_TYPE bit = (EVENT_FLAG_MATRIX_ROW_TYPE)1 << col;
+    uint32_t num, idx, cap;
+    evSlot_t *pSlotArr;
+
+    if (pEcb->processing) {                                                     //回调函数持有槽位指针，槽位数组不可移动
+        return NULL;
+    }
+
+    num = eventMatrix_BitCount(pRow->regMask);
+    idx = eventMatrix_BitCount(pRow->regMask & (bit - 1));
+
+    if (num == pRow->slotCap) {
+        cap = pRow->slotCap ? pRow->slotCap * 2 : 2;
+        if (cap > EVENT_MATRIX_COL) {
+            cap = EVENT_MATRIX_COL;
+        }
+        pSlotArr = (evSlot_t *)realloc(pRow->pSlotArr, cap * sizeof(evSlot_t));
+        if (pSlotArr == NULL) {
+            return NULL;
+        }
+        pRow->pSlotArr = pSlotArr;
+        pRow->slotCap = cap;
+    }
+
+    memmove(&pRow->pSlotArr[idx + 1], &pRow->pSlotArr[idx], (num - idx) * sizeof(evSlot_t));
+    memset(&pRow->pSlotArr[idx], 0, sizeof(evSlot_t));
+    pRow->regMask |= bit;
+
+    return &pRow->pSlotArr[idx];
+}
+
+/*******************************************************************************
+ *  @brief  读取稀疏事件矩阵回调函数存储位置
+ *  @param  pEcb - 事件控制块指针
+ *          row  - 行
+ *          col  - 列
+ *  @return 回调函数存储位置指针，事件未注册返回NULL
+ */
+static pEventCB_t *eventMatrix_SparseCbPtr(pEcb_t pEcb, int row, int col) {
+    evSlot_t *pSlot = eventMatrix_SparseSlot(pEcb, row, col);
+
+    return pSlot != NULL ? &pSlot->pCb : NULL;
+}
+
+/*******************************************************************************
+ *  @brief  读取稀疏事件矩阵参数存储位置
+ *  @param  pEcb - 事件控制块指针
+ *          row  - 行
+ *          col  - 列
+ *  @return 参数存储位置指针，事件未注册返回NULL
+ */
+static evParaSlot_t *eventMatrix_SparseParaPtr(pEcb_t pEcb, int row, int col) {
+    evSlot_t *pSlot = eventMatrix_SparseSlot(pEcb, row, col);
+
+    return pSlot != NULL ? &pSlot->para : NULL;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  分配扩展后的矩阵，复制原有行，新增行按字节填充
+ *  @param  pOld    - 原矩阵指针，可为NULL
+ *          rowSize - 每行字节数
+ *          oldRow  - 原行数
+ *          newRow  - 新行数
+ *          fill    - 新增行填充字节
+ *  @return 新矩阵指针，分配失败返回NULL
+ */
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+static void *eventMatrix_DynGrow(const void *pOld, size_t rowSize, int oldRow, int newRow, int fill) {
+    uint8_t *pNew = malloc(rowSize * newRow);
+
+    if (pNew != NULL) {
+        if (pOld != NULL && oldRow > 0) {
+            memcpy(pNew, pOld, rowSize * oldRow);
+        }
+        memset(pNew + rowSize * oldRow, fill, rowSize * (newRow - oldRow));
+    }
+    return pNew;
+}
+
+/*******************************************************************************
+ *  @brief  设置线程进入事件标志矩阵读取区，按扩展代数最低位选择引用计数
+ *          计数后代数已改变则重试，保证扩展线程等待的计数包含本线程
+ *  @param  pEcb - 事件控制块指针
+ *  @return 使用的引用计数序号，退出时传入
+ */
+static uint32_t eventMatrix_DynReadLock(pEcb_t pEcb) {
+    uint32_t idx;
+
+    for (;;) {
+        idx = __atomic_load_n(&pEcb->dynGen, __ATOMIC_SEQ_CST) & 1;
+        __atomic_fetch_add(&pEcb->dynRef[idx], 1, __ATOMIC_SEQ_CST);
+        if ((__atomic_load_n(&pEcb->dynGen, __ATOMIC_SEQ_CST) & 1) == idx) {
+            return idx;
+        }
+        __atomic_fetch_sub(&pEcb->dynRef[idx], 1, __ATOMIC_RELEASE);
+    }
+}
+
+/*******************************************************************************
+ *  @brief  设置线程退出事件标志矩阵读取区
+ *  @param  pEcb - 事件控制块指针
+ *          idx  - 进入时使用的引用计数序号
+ *  @return void
+ */
+static void eventMatrix_DynReadUnlock(pEcb_t pEcb, uint32_t idx) {
+    __atomic_fetch_sub(&pEcb->dynRef[idx], 1, __ATOMIC_RELEASE);
+}
+
+/*******************************************************************************
+ *  @brief  切换扩展代数并等待旧引用计数归零，此后不再有设置线程访问替换前的矩阵
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+static void eventMatrix_DynSync(pEcb_t pEcb) {
+    uint32_t idx = __atomic_fetch_add(&pEcb->dynGen, 1, __ATOMIC_SEQ_CST) & 1;
+
+    while (__atomic_load_n(&pEcb->dynRef[idx], __ATOMIC_ACQUIRE) != 0) {
+        sched_yield();
     }
-    return false;
 }
+#endif
 
 /******************************** END OF FILE **********************************
 *************************** (C) Copyright 2019 REIZ ***************************/
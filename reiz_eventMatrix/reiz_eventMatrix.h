@@ -30,45 +30,369 @@ extern "C"
 /* 事件矩阵列数 */
 #define EVENT_MATRIX_COL                (sizeof( EVENT_FLAG_MATRIX_ROW_TYPE ) * 8)
 
+/* 宏值：1为打开，0为关闭 */
+#define EVENT_PARA_QUEUE_ENABLE         0                                       //事件参数队列功能，事件处理前多次保存的参数按顺序依次分发
+#define EVENT_PARA_DROP_COUNT_ENABLE    1                                       //参数队列满时丢弃参数次数统计功能
+#define EVENT_OCCUR_COUNT_ENABLE        0                                       //事件发生次数统计功能，统计两次事件处理之间设置事件标志的次数，依赖参数队列功能
+#define EVENT_BATCH_CB_ENABLE           0                                       //批量事件处理回调函数功能，一次调用处理全部缓存参数，依赖参数队列功能
+#define EVENT_PRIORITY_ENABLE           0                                       //事件优先级功能，事件处理时高优先级类事件先于低优先级类事件处理
+#define EVENT_WAIT_ENABLE               0                                       //事件等待功能(Linux)，事件处理线程无事件时阻塞等待，其他线程设置事件标志时唤醒
+#define EVENT_TIMER_ENABLE              0                                       //事件定时器功能，延时及周期设置事件标志，见 reiz_eventMatrixTimer.h
+#define EVENT_STAT_ENABLE               0                                       //事件统计功能，统计事件分发次数、设置至分发延时及回调函数执行时长分布
+#define EVENT_SHARD_ENABLE              0                                       //分片设置事件标志功能，各设置线程写私有事件标志分片，事件处理时合并，减少跨核缓存行争用
+#define EVENT_MATRIX_SPARSE_ENABLE      0                                       //事件矩阵稀疏存储，每行仅存储已注册事件的回调函数及参数，注册时分配
+#define EVENT_ENABLE_MASK_ENABLE        0                                       //事件使能掩码功能，屏蔽的事件标志保留但不处理，解除屏蔽后处理
+#define EVENT_MATRIX_AOS_ENABLE         0                                       //事件矩阵槽位存储，每个事件的回调函数及参数相邻存储于同一槽位，分发时减少缓存缺失
+#define EVENT_RTC_ENABLE                0                                       //事件连续处理功能，一次调用反复轮询直至无待处理事件或处理预算用尽，回调函数中设置的事件同次处理
+#define EVENT_DEPEND_ENABLE             0                                       //事件依赖功能，声明生产者事件先于消费者事件处理，两者同时待处理时推迟消费者事件
+#define EVENT_MATRIX_DYNAMIC_ENABLE     0                                       //事件矩阵动态行数，各矩阵动态分配，注册事件时按最大事件标志扩展行数，扩展期间其他线程仍可设置事件标志
+#define EVENT_TRACE_ENABLE              0                                       //事件跟踪记录功能(Linux)，记录事件设置及处理过程并离线回放，见 reiz_eventMatrixTrace.h
+#define EVENT_AFFINITY_ENABLE           0                                       //事件亲和性功能(Linux)，注册时指定事件分发线程，事件处理时经无锁路由队列转交该线程执行回调函数
+#define EVENT_RECLAIM_ENABLE            0                                       //事件参数延迟回收功能(Linux)，回调函数执行后参数暂存于回收列表，一遍事件处理结束时批量释放或交由后台回收线程释放
+
+/* 每个事件参数队列深度，即事件处理前每个事件最多可缓存的参数个数 */
+#define EVENT_PARA_QUEUE_DEPTH          4
+
+/* 事件统计回调函数执行时长直方图区间数，第0区间时长为0，第n区间时长为 [2^(n-1), 2^n)，末区间包含更长时长 */
+#define EVENT_STAT_HIST_BINS            16
+
+/* 缓存行字节数，事件标志分片及路由队列生产者、消费者位置按缓存行对齐 */
+#define EVENT_CACHE_LINE_SIZE           64
+
+/* 事件分发线程路由队列容量，必须为2的幂 */
+#define EVENT_AFFINITY_QUEUE_SIZE       256
+
+/* 参数回收列表容量，一遍事件处理中回收列表满时立即批量释放 */
+#define EVENT_RECLAIM_BATCH             64
+
+/* 后台回收线程待释放参数数组容量，数组满时由事件处理线程直接释放 */
+#define EVENT_RECLAIMER_SIZE            1024
+
+/* 事件亲和性：不指定分发线程，在调用事件处理函数的线程中执行回调函数 */
+#define EVENT_AFFINITY_ANY              0
+
+/* 事件优先级类数目，最大为32，优先级类取值 0 ~ EVENT_PRIORITY_CLASS_NUM - 1，数值越大优先级越高 */
+#define EVENT_PRIORITY_CLASS_NUM        4
+
+#if (EVENT_OCCUR_COUNT_ENABLE || EVENT_BATCH_CB_ENABLE) && !EVENT_PARA_QUEUE_ENABLE
+#error "EVENT_OCCUR_COUNT_ENABLE and EVENT_BATCH_CB_ENABLE require EVENT_PARA_QUEUE_ENABLE"
+#endif
+
+#if EVENT_MATRIX_SPARSE_ENABLE && EVENT_MATRIX_AOS_ENABLE
+#error "EVENT_MATRIX_SPARSE_ENABLE and EVENT_MATRIX_AOS_ENABLE are mutually exclusive, sparse rows already use slot records"
+#endif
+
+#if EVENT_AFFINITY_ENABLE && EVENT_BATCH_CB_ENABLE
+#error "EVENT_AFFINITY_ENABLE does not support EVENT_BATCH_CB_ENABLE, routed events are dispatched one parameter at a time"
+#endif
+
+#if EVENT_AFFINITY_ENABLE && (EVENT_AFFINITY_QUEUE_SIZE & (EVENT_AFFINITY_QUEUE_SIZE - 1)) != 0
+#error "EVENT_AFFINITY_QUEUE_SIZE must be a power of 2"
+#endif
+
+#if EVENT_PRIORITY_ENABLE && (EVENT_PRIORITY_CLASS_NUM < 1 || EVENT_PRIORITY_CLASS_NUM > 32)
+#error "EVENT_PRIORITY_CLASS_NUM must be 1 ~ 32"
+#endif
+
 /* Exported macro ------------------------------------------------------------*/
 
+#if EVENT_SHARD_ENABLE
+/*
+    事件标志分片对象宏类型定义，每个分片的事件标志行按缓存行对齐，shardNum为分片数即最多可分片设置的线程数
+    使用方法：
+    EVENT_SHARD_OBJ(EVENT_MATRIX_ROW, 16) xxxEvShardObj;
+    eventMatrix_ShardInit(pEcb, xxxEvShardObj.headArr, &xxxEvShardObj.flagArr[0][0], 16, EVENT_SHARD_ROW_SIZE(EVENT_MATRIX_ROW));
+*/
+#define EVENT_SHARD_ROW_SIZE(row)                                                               \
+    ((((row) * sizeof(EVENT_FLAG_MATRIX_ROW_TYPE) + EVENT_CACHE_LINE_SIZE - 1) / EVENT_CACHE_LINE_SIZE) \
+     * EVENT_CACHE_LINE_SIZE / sizeof(EVENT_FLAG_MATRIX_ROW_TYPE))
+
+#define EVENT_SHARD_OBJ(row, shardNum)                                                          \
+struct {                                                                                        \
+    evShardHead_t               headArr[shardNum];                                              \
+    EVENT_FLAG_MATRIX_ROW_TYPE  flagArr[shardNum][EVENT_SHARD_ROW_SIZE(row)]                    \
+                                __attribute__((aligned(EVENT_CACHE_LINE_SIZE)));                \
+}
+#endif
+
 /*
     事件矩阵块宏类型定义
     使用方法：
     #define EVENT_MATRIX_ROW  2
     EVENT_PROCESS_OBJ(EVENT_MATRIX_ROW) xxxEvObj;
 */
-#define EVENT_PROCESS_OBJ(row)                                  \
-struct {                                                        \
-    EVENT_FLAG_MATRIX_ROW_TYPE          evFlagMatrix[row];      \
-    evCbMatrixRowArr_t                  evCbMatrix[row];        \
-    evParaMatrixRowArr_t                evParaMatrix[row];      \
+#if EVENT_PRIORITY_ENABLE
+/* 使能事件优先级时，各优先级类分别拥有一个事件标志矩阵，按优先级类顺序连续存储 */
+#define EVENT_FLAG_OBJ_ROW(row)         ((row) * EVENT_PRIORITY_CLASS_NUM)
+#define EVENT_PRIO_OBJ_MEMBER(row)      evPrioMatrixRowArr_t evPrioMatrix[row];
+#else
+#define EVENT_FLAG_OBJ_ROW(row)         (row)
+#define EVENT_PRIO_OBJ_MEMBER(row)
+#endif
+
+#if EVENT_ENABLE_MASK_ENABLE
+#define EVENT_ENABLE_OBJ_MEMBER(row)    EVENT_FLAG_MATRIX_ROW_TYPE evEnableMatrix[row];
+#else
+#define EVENT_ENABLE_OBJ_MEMBER(row)
+#endif
+
+#if EVENT_AFFINITY_ENABLE
+#define EVENT_AFFINITY_OBJ_MEMBER(row)  evAffinityMatrixRowArr_t evAffinityMatrix[row];
+#else
+#define EVENT_AFFINITY_OBJ_MEMBER(row)
+#endif
+
+#if EVENT_DEPEND_ENABLE
+#define EVENT_DEP_OBJ_MEMBER(row)       EVENT_FLAG_MATRIX_ROW_TYPE evDepMatrix[row];
+#else
+#define EVENT_DEP_OBJ_MEMBER(row)
+#endif
+
+#if EVENT_MATRIX_SPARSE_ENABLE
+/* 使能稀疏存储时，回调函数及参数按行存储于注册时分配的槽位数组中 */
+#define EVENT_SLOT_OBJ_MEMBER(row)      evSparseRow_t evSparseMatrix[row];
+#elif EVENT_MATRIX_AOS_ENABLE
+/* 使能槽位存储时，回调函数及参数按事件存储于同一槽位 */
+#define EVENT_SLOT_OBJ_MEMBER(row)      evSlotRowArr_t evSlotMatrix[row];
+#else
+#define EVENT_SLOT_OBJ_MEMBER(row)      evCbMatrixRowArr_t evCbMatrix[row]; evParaMatrixRowArr_t evParaMatrix[row];
+#endif
+
+#define EVENT_PROCESS_OBJ(row)                                                  \
+struct {                                                                        \
+    EVENT_FLAG_MATRIX_ROW_TYPE          evFlagMatrix[EVENT_FLAG_OBJ_ROW(row)];  \
+    EVENT_SLOT_OBJ_MEMBER(row)                                                  \
+    EVENT_PRIO_OBJ_MEMBER(row)                                                  \
+    EVENT_ENABLE_OBJ_MEMBER(row)                                                \
+    EVENT_AFFINITY_OBJ_MEMBER(row)                                              \
+    EVENT_DEP_OBJ_MEMBER(row)                                                   \
 }
 
 /* Exported types ------------------------------------------------------------*/
 typedef EVENT_FLAG_MATRIX_ROW_TYPE (*pEvFlagMatrix_t)[];                        //事件标志矩阵指针类型定义
 typedef void (*pEventCB_t)(void *pPara);                                        //事件处理回调函数指针类型定义
+typedef uint32_t (*pEvGetTick_t)(void);                                         //tick读取函数指针类型定义
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+typedef struct evDynFlagMatrix_ {                                               //动态事件标志矩阵类型定义，行数与事件标志同一次分配，设置线程读取一致快照
+    int                         matrixRow;
+    EVENT_FLAG_MATRIX_ROW_TYPE  flagArr[];                                      //使能事件优先级时按优先级类顺序连续存储
+} evDynFlagMatrix_t;
+#endif
+#if EVENT_BATCH_CB_ENABLE
+typedef void (*pEventBatchCB_t)(void **ppPara, int paraNum, uint32_t occurTimes);   //批量事件处理回调函数指针类型定义
+#endif
 typedef pEventCB_t evCbMatrixRowArr_t[EVENT_MATRIX_COL];                        //事件回调函数矩阵行元素类型定义
 typedef evCbMatrixRowArr_t (*pEvCbMatrix_t)[];                                  //事件回调函数矩阵指针类型定义
-typedef void *evParaMatrixRowArr_t[EVENT_MATRIX_COL];                           //事件回调函数参数矩阵行元素类型定义
+#if EVENT_PARA_QUEUE_ENABLE
+typedef struct evParaQueue_ {                                                   //事件参数队列类型定义，存储空间随事件处理对象静态分配
+    void                *pParaBuf[EVENT_PARA_QUEUE_DEPTH];                      //参数指针存储数组，按保存顺序排列
+    uint32_t            count;                                                  //队列当前存储参数个数
+#if EVENT_PARA_DROP_COUNT_ENABLE
+    uint32_t            dropTimes;                                              //队列满时参数丢弃次数
+#endif
+#if EVENT_OCCUR_COUNT_ENABLE
+    uint32_t            occurTimes;                                             //自上次事件处理以来事件发生次数
+#endif
+#if EVENT_BATCH_CB_ENABLE
+    pEventBatchCB_t     pBatchCb;                                               //批量事件处理回调函数指针，NULL为普通事件处理回调函数
+#endif
+} evParaQueue_t;
+typedef evParaQueue_t evParaSlot_t;                                             //单个事件参数存储类型定义
+#else
+typedef void *evParaSlot_t;                                                     //单个事件参数存储类型定义
+#endif
+typedef evParaSlot_t evParaMatrixRowArr_t[EVENT_MATRIX_COL];                    //事件回调函数参数矩阵行元素类型定义
 typedef evParaMatrixRowArr_t (*pEvParaMatrix_t)[];                              //事件参数矩阵指针类型定义
+#if EVENT_MATRIX_SPARSE_ENABLE || EVENT_MATRIX_AOS_ENABLE
+typedef struct evSlot_ {                                                        //事件槽位类型定义，回调函数与参数相邻存储，未使能参数队列时为两个指针大小
+    pEventCB_t          pCb;
+    evParaSlot_t        para;
+} evSlot_t;
+#endif
+#if EVENT_MATRIX_AOS_ENABLE
+typedef evSlot_t evSlotRowArr_t[EVENT_MATRIX_COL];                              //事件槽位矩阵行元素类型定义
+typedef evSlotRowArr_t (*pEvSlotMatrix_t)[];                                    //事件槽位矩阵指针类型定义
+#endif
+#if EVENT_MATRIX_SPARSE_ENABLE
+typedef struct evSparseRow_ {                                                   //稀疏事件矩阵行类型定义
+    EVENT_FLAG_MATRIX_ROW_TYPE  regMask;                                        //注册位图，第n位为1表示第n列事件已分配槽位
+    uint32_t                    slotCap;                                        //槽位数组容量
+    evSlot_t                    *pSlotArr;                                      //槽位数组，按列顺序存储已注册事件，下标为注册位图中低于该列的位数
+} evSparseRow_t;
+typedef evSparseRow_t (*pEvSparseMatrix_t)[];                                   //稀疏事件矩阵指针类型定义
+#endif
+#if EVENT_PRIORITY_ENABLE
+typedef uint8_t evPrioMatrixRowArr_t[EVENT_MATRIX_COL];                         //事件优先级类矩阵行元素类型定义
+typedef evPrioMatrixRowArr_t (*pEvPrioMatrix_t)[];                              //事件优先级类矩阵指针类型定义
+#endif
+
+#if EVENT_RECLAIM_ENABLE
+#include <pthread.h>
+
+typedef struct evReclaimer_ {                                                   //后台回收线程类型定义，事件处理线程提交待释放参数，回收线程批量释放
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    pthread_t           thread;
+    bool                run;                                                    //回收线程运行中
+    int                 cur;                                                    //提交使用的待释放数组，回收线程取走后切换
+    uint32_t            num;                                                    //当前待释放数组中参数个数
+    uint32_t            fullTimes;                                              //待释放数组满次数，此时由事件处理线程直接释放
+    void                *pParaArr[2][EVENT_RECLAIMER_SIZE];                     //双缓冲待释放数组
+} evReclaimer_t, *pEvReclaimer_t;
+
+typedef struct evReclaim_ {                                                     //参数回收列表类型定义，每个事件处理线程及分发线程一个
+    bool                enable;                                                 //延迟回收使能，未使能时回调函数执行后立即释放参数
+    uint32_t            num;                                                    //回收列表中参数个数
+    pEvReclaimer_t      pReclaimer;                                             //后台回收线程指针，NULL为一遍事件处理结束时在本线程批量释放
+    void                *pParaArr[EVENT_RECLAIM_BATCH];
+} evReclaim_t;
+#endif
+
+#if EVENT_AFFINITY_ENABLE
+typedef uint8_t evAffinityMatrixRowArr_t[EVENT_MATRIX_COL];                     //事件亲和性矩阵行元素类型定义
+typedef evAffinityMatrixRowArr_t (*pEvAffinityMatrix_t)[];                      //事件亲和性矩阵指针类型定义
+
+typedef struct evRouteCell_ {                                                   //路由队列单元类型定义
+    uint32_t            seq;                                                    //单元序号，等于入队位置时可写，等于入队位置+1时可读
+    pEventCB_t          pCb;                                                    //事件处理回调函数指针
+    void                *pPara;                                                 //事件参数，回调函数执行后由分发线程释放
+#if EVENT_STAT_ENABLE
+    struct eventControlBlock_ *pEcb;                                            //转交事件的事件控制块指针，分发线程据此统计
+    int                 eventFlag;                                              //转交事件的事件标志
+#endif
+} evRouteCell_t;
+
+typedef struct evDispatcher_ {                                                  //事件分发线程类型定义，多生产者单消费者无锁路由队列
+    uint32_t            enqPos __attribute__((aligned(EVENT_CACHE_LINE_SIZE))); //入队位置，各事件处理线程竞争写入
+    uint32_t            fullTimes;                                              //路由队列满次数，队列满时事件留待下次事件处理转交
+    uint32_t            deqPos __attribute__((aligned(EVENT_CACHE_LINE_SIZE))); //出队位置，仅分发线程写入
+    int                 waitArmed;                                              //分发线程准备睡眠标志
+    int                 wakeFd;                                                 //唤醒eventfd文件描述符
+    const char          *pName;                                                 //分发线程名称
+#if EVENT_RECLAIM_ENABLE
+    evReclaim_t         reclaim;                                                //分发线程参数回收列表
+#endif
+    evRouteCell_t       cellArr[EVENT_AFFINITY_QUEUE_SIZE];
+} evDispatcher_t, *pEvDispatcher_t;
+#endif
+
+#if EVENT_DEPEND_ENABLE
+typedef struct evDep_ {                                                         //事件依赖类型定义
+    int                 producer;                                               //生产者事件标志
+    int                 consumer;                                               //消费者事件标志，生产者待处理时推迟处理
+    bool                visit;                                                  //添加依赖时环检测临时标记
+} evDep_t, *pEvDep_t;
+#endif
+
+#if EVENT_SHARD_ENABLE
+typedef struct evShardHead_ {                                                   //事件标志分片头类型定义，独占一个缓存行
+    uint32_t            dirty;                                                  //分片中有未合并的事件标志
+} __attribute__((aligned(EVENT_CACHE_LINE_SIZE))) evShardHead_t;
+#endif
+
+#if EVENT_STAT_ENABLE
+typedef struct evStat_ {                                                        //事件统计信息类型定义，时间单位为统计tick读取函数的单位
+    uint32_t            postTime;                                               //事件标志设置时间
+    uint32_t            dispatchTimes;                                          //事件分发次数
+    uint32_t            latencyMax;                                             //设置至分发最大延时
+    uint64_t            latencySum;                                             //设置至分发延时累计，除以分发次数得平均延时
+    uint32_t            durationMax;                                            //回调函数最长执行时长
+    uint32_t            durationHist[EVENT_STAT_HIST_BINS];                     //回调函数执行时长直方图
+} evStat_t, *pEvStat_t;
+#endif
 
 typedef struct eventControlBlock_ {                                             //事件控制块类型定义
     int                 matrixRow;
     pEvFlagMatrix_t     pEvFlagMatrix;                                          //事件标志矩阵指针
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    evDynFlagMatrix_t   *pDynFlag;                                              //动态事件标志矩阵指针，扩展时原子替换
+    uint32_t            dynGen;                                                 //扩展代数，最低位选择设置线程使用的引用计数
+    uint32_t            dynRef[2];                                              //正在访问事件标志矩阵的设置线程数，扩展后等待旧计数归零再释放旧矩阵
+#endif
+#if EVENT_MATRIX_SPARSE_ENABLE || EVENT_MATRIX_DYNAMIC_ENABLE
+    bool                processing;                                             //事件处理中，此时不可分配新槽位或扩展矩阵
+#endif
+#if EVENT_MATRIX_SPARSE_ENABLE
+    pEvSparseMatrix_t   pEvSparseMatrix;                                        //稀疏事件矩阵指针
+#elif EVENT_MATRIX_AOS_ENABLE
+    pEvSlotMatrix_t     pEvSlotMatrix;                                          //事件槽位矩阵指针
+#else
     pEvCbMatrix_t       pEvCbMatrix;                                            //事件处理回调函数矩阵指针
     pEvParaMatrix_t     pEvParaMatrix;                                          //事件参数矩阵指针
+#endif
+#if EVENT_PRIORITY_ENABLE
+    pEvPrioMatrix_t     pEvPrioMatrix;                                          //事件优先级类矩阵指针
+    uint32_t            prioMask;                                               //优先级类待处理掩码，第n位为1表示优先级类n可能有事件待处理
+#endif
+#if EVENT_ENABLE_MASK_ENABLE
+    pEvFlagMatrix_t     pEvEnableMatrix;                                        //事件使能掩码矩阵指针，第n位为0表示该事件被屏蔽
+#endif
+#if EVENT_AFFINITY_ENABLE
+    pEvAffinityMatrix_t pEvAffinityMatrix;                                      //事件亲和性矩阵指针，元素为分发线程序号+1
+    pEvDispatcher_t     *pDispatcherArr;                                        //事件分发线程指针数组
+    int                 dispatcherNum;                                          //事件分发线程数
+#endif
+#if EVENT_RTC_ENABLE
+    uint32_t            budget;                                                 //本次调用剩余可执行回调函数次数
+#endif
+#if EVENT_DEPEND_ENABLE
+    pEvFlagMatrix_t     pEvDepMatrix;                                           //消费者位图矩阵指针，第n位为1表示该事件有生产者
+    pEvDep_t            pDepArr;                                                //事件依赖数组指针
+    int                 depNum;                                                 //事件依赖数
+    int                 depCap;                                                 //事件依赖数组容量
+#endif
+#if EVENT_RECLAIM_ENABLE
+    evReclaim_t         reclaim;                                                //事件处理线程参数回收列表
+#endif
+#if EVENT_SHARD_ENABLE
+    evShardHead_t       *pShardHead;                                            //事件标志分片头数组指针
+    EVENT_FLAG_MATRIX_ROW_TYPE *pShardFlag;                                     //事件标志分片数组指针，分片依次连续存储
+    int                 shardNum;                                               //分片数
+    int                 shardRowSize;                                           //每个分片行数，按缓存行对齐
+#endif
+#if EVENT_WAIT_ENABLE
+    int                 waitFd;                                                 //事件等待唤醒eventfd文件描述符
+    int                 waitArmed;                                              //事件处理线程准备睡眠标志，设置事件标志时据此唤醒
+#endif
+#if EVENT_TIMER_ENABLE
+    struct evTimer_     *pTimer;                                                //事件定时器指针
+#endif
+#if EVENT_STAT_ENABLE
+    pEvStat_t           pEvStatTable;                                           //事件统计信息表指针，按事件标志索引
+    int                 statNum;                                                //事件统计信息表长度
+    pEvGetTick_t        pStatGetTime;                                           //统计时间读取函数指针
+#endif
 } ecb_t, *pEcb_t;
 
 /* Exported variables --------------------------------------------------------*/
 
 /* Exported functions prototypes ---------------------------------------------*/
 
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+extern bool eventMatrix_ecbDynInit(pEcb_t pEcb, int matrixRow);                 //动态事件控制块初始化，按初始行数分配各矩阵
+extern void eventMatrix_ecbDynDeinit(pEcb_t pEcb);                              //动态事件控制块去初始化，释放未处理参数及各矩阵
+extern bool eventMatrix_Resize(pEcb_t pEcb, int matrixRow);                     //扩展事件矩阵行数，仅可增加
+#if EVENT_MATRIX_SPARSE_ENABLE
+extern void eventMatrix_ecbSparseDeinit(pEcb_t pEcb);                           //稀疏存储事件控制块去初始化，释放槽位数组
+#endif
+#elif EVENT_MATRIX_SPARSE_ENABLE
+extern bool eventMatrix_ecbSparseInit(  pEcb_t              pEcb,               //稀疏存储事件控制块初始化
+                                        int                 matrixRow,
+                                        pEvFlagMatrix_t     pEvFlagMatrix,
+                                        pEvSparseMatrix_t   pEvSparseMatrix);
+extern void eventMatrix_ecbSparseDeinit(pEcb_t pEcb);                           //稀疏存储事件控制块去初始化，释放槽位数组
+#elif EVENT_MATRIX_AOS_ENABLE
+extern bool eventMatrix_ecbSlotInit(pEcb_t              pEcb,                   //槽位存储事件控制块初始化
+                                    int                 matrixRow,
+                                    pEvFlagMatrix_t     pEvFlagMatrix,
+                                    pEvSlotMatrix_t     pEvSlotMatrix);
+#else
 extern bool eventMatrix_ecbInit(    pEcb_t              pEcb,                   //事件控制块初始化
                                     int                 matrixRow,
                                     pEvFlagMatrix_t     pEvFlagMatrix,
                                     pEvCbMatrix_t       pEvCbMatrix,
                                     pEvParaMatrix_t     pEvParaMatrix);
+#endif
 
 extern void eventMatrix_EventProcess(pEcb_t pEcb);                              //事件处理函数，轮询事件矩阵
 extern bool eventMatrix_SetEventFlag(pEcb_t pEcb, int eventFlag);               //设置事件标志
@@ -76,6 +400,95 @@ extern bool eventMatrix_GetEventFlag(pEcb_t pEcb, int eventFlag);
 extern bool eventMatrix_ClearEventFlag(pEcb_t pEcb, int eventFlag);             //清除事件标志
 extern bool eventMatrix_SaveEventPara(pEcb_t pEcb, int eventFlag, void *pPara); //保存事件参数集合数据结构指针，以供事件处理回调函数使用
 extern bool eventMatrix_RegistEvCB(pEcb_t pEcb, int eventFlag, pEventCB_t pCb); //注册事件处理回调函数
+extern bool eventMatrix_SetEventFlagList(pEcb_t pEcb, const int *pEventArr, int eventNum);                      //批量设置事件标志列表
+extern bool eventMatrix_SetEventFlagBitmap(pEcb_t pEcb, const EVENT_FLAG_MATRIX_ROW_TYPE *pBitmap, int rowNum); //按行位图批量设置事件标志
+
+#if EVENT_ENABLE_MASK_ENABLE
+extern bool eventMatrix_ecbEnableInit(pEcb_t pEcb, pEvFlagMatrix_t pEvEnableMatrix);                            //事件使能掩码矩阵初始化，初始全部使能
+extern bool eventMatrix_EnableEventBitmap(pEcb_t pEcb, const EVENT_FLAG_MATRIX_ROW_TYPE *pBitmap, int rowNum);  //按行位图解除屏蔽事件
+extern bool eventMatrix_DisableEventBitmap(pEcb_t pEcb, const EVENT_FLAG_MATRIX_ROW_TYPE *pBitmap, int rowNum); //按行位图屏蔽事件
+#endif
+
+#if EVENT_PRIORITY_ENABLE
+extern bool eventMatrix_ecbPrioInit(pEcb_t pEcb, pEvPrioMatrix_t pEvPrioMatrix);                //事件优先级类矩阵初始化
+extern bool eventMatrix_RegistEvCBPrio(pEcb_t pEcb, int eventFlag, pEventCB_t pCb, int prio);   //注册事件处理回调函数并指定事件优先级类
+extern void eventMatrix_EventProcessTopClass(pEcb_t pEcb);                                      //事件处理函数，仅处理最高待处理优先级类事件
+#endif
+
+#if EVENT_RTC_ENABLE
+extern bool eventMatrix_EventProcessRTC(pEcb_t pEcb, uint32_t budget);          //事件连续处理函数，返回true表示已无待处理事件
+#endif
+
+#if EVENT_DEPEND_ENABLE
+extern bool eventMatrix_ecbDepInit(pEcb_t pEcb, pEvFlagMatrix_t pEvDepMatrix, pEvDep_t pDepArr, int depCap);    //事件依赖初始化
+extern bool eventMatrix_AddEventDep(pEcb_t pEcb, int producer, int consumer);                                   //添加事件依赖，形成环时失败
+extern bool eventMatrix_RemoveEventDep(pEcb_t pEcb, int producer, int consumer);                                //删除事件依赖
+#endif
+
+#if EVENT_AFFINITY_ENABLE
+extern bool eventMatrix_ecbAffinityInit(pEcb_t              pEcb,               //事件亲和性初始化，绑定事件亲和性矩阵及分发线程
+                                        pEvAffinityMatrix_t pEvAffinityMatrix,
+                                        pEvDispatcher_t     *pDispatcherArr,
+                                        int                 dispatcherNum);
+extern bool eventMatrix_RegistEvCBAffinity(pEcb_t pEcb, int eventFlag, pEventCB_t pCb, int affinity);   //注册事件处理回调函数并指定分发线程，affinity为分发线程序号+1
+extern bool eventMatrix_DispatcherInit(pEvDispatcher_t pDisp, const char *pName);                       //事件分发线程初始化，创建唤醒文件描述符
+extern void eventMatrix_DispatcherDeinit(pEvDispatcher_t pDisp);                                        //事件分发线程去初始化，关闭唤醒文件描述符
+extern int  eventMatrix_DispatcherGetFd(pEvDispatcher_t pDisp);                                         //读取唤醒文件描述符，可加入epoll
+extern int  eventMatrix_DispatcherProcess(pEvDispatcher_t pDisp);                                       //执行路由队列中的事件回调函数，返回执行个数
+extern bool eventMatrix_DispatcherWait(pEvDispatcher_t pDisp, int timeoutMs);                           //阻塞等待路由队列非空，超时返回false
+#endif
+
+#if EVENT_RECLAIM_ENABLE
+extern bool eventMatrix_ecbReclaimInit(pEcb_t pEcb, pEvReclaimer_t pReclaimer);                         //使能事件参数延迟回收，pReclaimer为NULL时每遍事件处理结束批量释放
+extern bool eventMatrix_ReclaimerStart(pEvReclaimer_t pReclaimer);                                      //创建后台回收线程
+extern void eventMatrix_ReclaimerStop(pEvReclaimer_t pReclaimer);                                       //停止后台回收线程，释放剩余参数
+#if EVENT_AFFINITY_ENABLE
+extern bool eventMatrix_DispatcherReclaimInit(pEvDispatcher_t pDisp, pEvReclaimer_t pReclaimer);        //使能分发线程参数延迟回收
+#endif
+#endif
+
+#if EVENT_SHARD_ENABLE
+extern bool eventMatrix_ShardInit(  pEcb_t                      pEcb,           //事件标志分片初始化
+                                    evShardHead_t               *pShardHead,
+                                    EVENT_FLAG_MATRIX_ROW_TYPE  *pShardFlag,
+                                    int                         shardNum,
+                                    int                         shardRowSize);
+extern void eventMatrix_ShardBind(int shardId);                                 //绑定本线程使用的分片，-1为不使用分片
+#endif
+
+#if EVENT_WAIT_ENABLE
+extern bool eventMatrix_WaitInit(pEcb_t pEcb);                                  //事件等待初始化，创建唤醒文件描述符
+extern void eventMatrix_WaitDeinit(pEcb_t pEcb);                                //事件等待去初始化，关闭唤醒文件描述符
+extern int  eventMatrix_GetWaitFd(pEcb_t pEcb);                                 //读取唤醒文件描述符，可加入epoll
+extern bool eventMatrix_WaitPrepare(pEcb_t pEcb);                               //准备睡眠，返回false表示已有事件待处理不可睡眠
+extern void eventMatrix_WaitFinish(pEcb_t pEcb);                                //结束睡眠，清除唤醒状态
+extern bool eventMatrix_Wait(pEcb_t pEcb, int timeoutMs);                       //阻塞等待事件标志，超时返回false
+#endif
+
+#if EVENT_STAT_ENABLE
+extern bool eventMatrix_StatInit(pEcb_t pEcb, pEvStat_t pEvStatTable, int statNum, pEvGetTick_t pGetTime);  //事件统计初始化
+extern bool eventMatrix_StatSnapshot(pEcb_t pEcb, int eventFlag, pEvStat_t pStat);                          //读取事件统计信息快照
+extern void eventMatrix_StatReset(pEcb_t pEcb);                                                             //清零全部事件统计信息
+#endif
+
+#if EVENT_TRACE_ENABLE
+extern bool eventMatrix_SaveEventParaSz(pEcb_t pEcb, int eventFlag, void *pPara, uint32_t paraSize);   //保存事件参数并记录参数大小
+#endif
+
+#if EVENT_PARA_QUEUE_ENABLE
+extern int eventMatrix_GetParaCount(pEcb_t pEcb, int eventFlag);                //读取事件参数队列当前缓存参数个数
+#if EVENT_PARA_DROP_COUNT_ENABLE
+extern uint32_t eventMatrix_GetParaDropTimes(pEcb_t pEcb, int eventFlag);       //读取事件参数队列丢弃参数次数
+#endif
+#endif
+
+#if EVENT_OCCUR_COUNT_ENABLE
+extern uint32_t eventMatrix_GetOccurTimes(pEcb_t pEcb, int eventFlag);          //读取事件发生次数
+#endif
+
+#if EVENT_BATCH_CB_ENABLE
+extern bool eventMatrix_RegistEvBatchCB(pEcb_t pEcb, int eventFlag, pEventBatchCB_t pBatchCb);  //注册批量事件处理回调函数
+#endif
 
 #ifdef __cplusplus
 }
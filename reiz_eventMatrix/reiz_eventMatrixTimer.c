@@ -0,0 +1,351 @@
+/*******************************************************************************
+ *  @file       reiz_eventMatrixTimer.c
+ *  @author     jxndsfss
+ *  @version    v1.0.0
+ *  @date       2026-10-19
+ *  @site       ShangYouSong.SZ
+ *  @brief      事件矩阵定时器源文件，分层时间轮实现延时事件及周期事件
+ *******************************************************************************
+ */
+
+/*******************************************************************************
+ *  @algorithm  分层时间轮：第n层每个槽位跨度为 2^(n * EVENT_TIMER_WHEEL_BITS) 个tick，
+ *              定时器按剩余tick数插入对应层槽位(O(1))，从槽位链表摘除即取消(O(1))；
+ *              第0层槽位轮转一圈时将上一层当前槽位的定时器重新插入下层(级联)，
+ *              第0层当前槽位中的定时器到期，设置其事件标志
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "reiz_eventMatrixTimer.h"
+
+#if EVENT_TIMER_ENABLE
+
+/* Private define ------------------------------------------------------------*/
+
+#define EVENT_TIMER_WHEEL_MASK          (EVENT_TIMER_WHEEL_SLOT - 1)
+
+/* 时间轮可表示的最大tick跨度 */
+#define EVENT_TIMER_WHEEL_SPAN          ((uint32_t)1 << (EVENT_TIMER_WHEEL_LEVEL * EVENT_TIMER_WHEEL_BITS))
+
+/* Private macro -------------------------------------------------------------*/
+/* Private typedef -----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void eventMatrix_TimerListInit(evTimerList_t *pHead);
+static void eventMatrix_TimerListUnlink(evTimerList_t *pEntry);
+static void eventMatrix_TimerInsert(pEvTimer_t pTimer, pEvTimerNode_t pNode);
+static void eventMatrix_TimerCascade(pEvTimer_t pTimer, int level, uint32_t idx);
+static void eventMatrix_TimerFire(pEcb_t pEcb, uint32_t idx);
+static pEvTimerNode_t eventMatrix_TimerStart(pEcb_t pEcb, int eventFlag, uint32_t delay, uint32_t period);
+
+/*******************************************************************************
+ *  @brief  事件定时器初始化
+ *  @param  pEcb     - 事件控制块指针
+ *          pTimer   - 事件定时器指针
+ *          pNodeArr - 定时器节点数组指针
+ *          nodeNum  - 定时器节点数，即同时存在的最大定时器数
+ *          pGetTick - tick读取函数指针
+ *  @return true     - 初始化成功
+ *          false    - 初始化失败
+ */
+extern bool eventMatrix_TimerInit(  pEcb_t              pEcb,
+                                    pEvTimer_t          pTimer,
+                                    evTimerNode_t       *pNodeArr,
+                                    int                 nodeNum,
+                                    pEvGetTick_t        pGetTick)
+{
+    int level, idx;
+
+    if (pEcb == NULL || pTimer == NULL || pNodeArr == NULL || nodeNum <= 0 || pGetTick == NULL) {
+        return false;
+    }
+
+    for (level = 0; level < EVENT_TIMER_WHEEL_LEVEL; level++) {
+        for (idx = 0; idx < EVENT_TIMER_WHEEL_SLOT; idx++) {
+            eventMatrix_TimerListInit(&pTimer->wheel[level][idx]);
+        }
+    }
+
+    pTimer->pFreeList = NULL;
+    for (idx = nodeNum - 1; idx >= 0; idx--) {                                  //所有节点放入空闲链表
+        pNodeArr[idx].active     = false;
+        pNodeArr[idx].list.pNext = (evTimerList_t *)pTimer->pFreeList;
+        pTimer->pFreeList        = &pNodeArr[idx];
+    }
+
+    pTimer->pGetTick    =   pGetTick;
+    pTimer->curTick     =   pGetTick();
+    pTimer->activeNum   =   0;
+    pEcb->pTimer        =   pTimer;
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  延时delay个tick后设置事件标志，单次定时器到期后节点自动回收，其指针随之失效
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          delay     - 延时tick数
+ *  @return 定时器节点指针，可用于取消定时器，NULL为启动失败
+ */
+extern pEvTimerNode_t eventMatrix_SetEventFlagAfter(pEcb_t pEcb, int eventFlag, uint32_t delay) {
+    return eventMatrix_TimerStart(pEcb, eventFlag, delay, 0);
+}
+
+/*******************************************************************************
+ *  @brief  延时delay个tick后以period为周期设置事件标志，直至取消定时器
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          delay     - 首次延时tick数
+ *          period    - 周期tick数，不可为0
+ *  @return 定时器节点指针，可用于取消定时器，NULL为启动失败
+ */
+extern pEvTimerNode_t eventMatrix_SetEventFlagPeriodic(pEcb_t pEcb, int eventFlag, uint32_t delay, uint32_t period) {
+    if (period == 0) {
+        return NULL;
+    }
+    return eventMatrix_TimerStart(pEcb, eventFlag, delay, period);
+}
+
+/*******************************************************************************
+ *  @brief  取消定时器，节点回收
+ *  @param  pEcb  - 事件控制块指针
+ *          pNode - 定时器节点指针
+ *  @return true  - 取消成功
+ *          false - 定时器未运行
+ */
+extern bool eventMatrix_TimerCancel(pEcb_t pEcb, pEvTimerNode_t pNode) {
+    pEvTimer_t pTimer;
+
+    if (pEcb == NULL || pEcb->pTimer == NULL || pNode == NULL || !pNode->active) {
+        return false;
+    }
+
+    pTimer = pEcb->pTimer;
+    eventMatrix_TimerListUnlink(&pNode->list);
+    pNode->active       = false;
+    pNode->list.pNext   = (evTimerList_t *)pTimer->pFreeList;
+    pTimer->pFreeList   = pNode;
+    pTimer->activeNum--;
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  推进时间轮至当前tick，设置到期定时器的事件标志，由 eventMatrix_EventProcess 调用
+ *  @param  pEcb - 事件控制块指针
+ *  @return void
+ */
+extern void eventMatrix_TimerAdvance(pEcb_t pEcb) {
+    pEvTimer_t  pTimer;
+    uint32_t    now, idx, cascadeIdx;
+    int         level;
+
+    if (pEcb == NULL || pEcb->pTimer == NULL) {
+        return;
+    }
+
+    pTimer = pEcb->pTimer;
+    now = pTimer->pGetTick();
+
+    while ((int32_t)(now - pTimer->curTick) >= 0) {
+        if (pTimer->activeNum == 0) {                                           //无运行中定时器，直接跳至当前tick
+            pTimer->curTick = now + 1;
+            break;
+        }
+
+        idx = pTimer->curTick & EVENT_TIMER_WHEEL_MASK;
+        if (idx == 0) {                                                         //第0层轮转一圈，逐层级联
+            for (level = 1; level < EVENT_TIMER_WHEEL_LEVEL; level++) {
+                cascadeIdx = (pTimer->curTick >> (level * EVENT_TIMER_WHEEL_BITS)) & EVENT_TIMER_WHEEL_MASK;
+                eventMatrix_TimerCascade(pTimer, level, cascadeIdx);
+                if (cascadeIdx != 0) {
+                    break;
+                }
+            }
+        }
+
+        eventMatrix_TimerFire(pEcb, idx);
+        pTimer->curTick++;
+    }
+}
+
+/*******************************************************************************
+ *  @brief  读取距离下次需推进时间轮的tick数，可作为 eventMatrix_Wait 的超时时间
+ *  @param  pEcb - 事件控制块指针
+ *  @return tick数，-1为无运行中定时器
+ */
+extern int eventMatrix_TimerNextTimeout(pEcb_t pEcb) {
+    pEvTimer_t  pTimer;
+    uint32_t    tick, now;
+
+    if (pEcb == NULL || pEcb->pTimer == NULL || pEcb->pTimer->activeNum == 0) {
+        return -1;
+    }
+
+    pTimer = pEcb->pTimer;
+    tick = pTimer->curTick;
+    do {                                                                        //查找第0层剩余槽位中最近的非空槽位，否则至下次级联
+        if (pTimer->wheel[0][tick & EVENT_TIMER_WHEEL_MASK].pNext != &pTimer->wheel[0][tick & EVENT_TIMER_WHEEL_MASK]) {
+            break;
+        }
+        tick++;
+    } while (tick & EVENT_TIMER_WHEEL_MASK);
+
+    now = pTimer->pGetTick();
+    return (int32_t)(tick - now) > 0 ? (int)(tick - now) : 0;
+}
+
+/*******************************************************************************
+ *  @brief  启动定时器
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          delay     - 首次延时tick数
+ *          period    - 周期tick数，0为单次定时器
+ *  @return 定时器节点指针，NULL为启动失败
+ */
+static pEvTimerNode_t eventMatrix_TimerStart(pEcb_t pEcb, int eventFlag, uint32_t delay, uint32_t period) {
+    pEvTimer_t      pTimer;
+    pEvTimerNode_t  pNode;
+
+    if (pEcb == NULL || pEcb->pTimer == NULL || pEcb->pTimer->pFreeList == NULL) {
+        return NULL;
+    }
+
+    pTimer = pEcb->pTimer;
+    pNode = pTimer->pFreeList;
+    pTimer->pFreeList = (evTimerNode_t *)pNode->list.pNext;
+
+    pNode->expire       = pTimer->pGetTick() + delay;
+    pNode->period       = period;
+    pNode->eventFlag    = eventFlag;
+    pNode->active       = true;
+    pTimer->activeNum++;
+    eventMatrix_TimerInsert(pTimer, pNode);
+
+    return pNode;
+}
+
+/*******************************************************************************
+ *  @brief  按到期tick将定时器插入对应层槽位，超出时间轮跨度的定时器暂存于最高层，级联时重新插入
+ *  @param  pTimer - 事件定时器指针
+ *          pNode  - 定时器节点指针
+ *  @return void
+ */
+static void eventMatrix_TimerInsert(pEvTimer_t pTimer, pEvTimerNode_t pNode) {
+    uint32_t        expire = pNode->expire;
+    uint32_t        delta = expire - pTimer->curTick;
+    int             level;
+    evTimerList_t   *pHead;
+
+    if ((int32_t)delta < 0) {                                                   //已到期，下一个待处理tick时触发
+        expire = pTimer->curTick;
+        delta = 0;
+    } else if (delta >= EVENT_TIMER_WHEEL_SPAN) {
+        expire = pTimer->curTick + EVENT_TIMER_WHEEL_SPAN - 1;
+        delta = EVENT_TIMER_WHEEL_SPAN - 1;
+    }
+
+    for (level = 0; level < EVENT_TIMER_WHEEL_LEVEL - 1; level++) {
+        if (delta < ((uint32_t)1 << ((level + 1) * EVENT_TIMER_WHEEL_BITS))) {
+            break;
+        }
+    }
+
+    pHead = &pTimer->wheel[level][(expire >> (level * EVENT_TIMER_WHEEL_BITS)) & EVENT_TIMER_WHEEL_MASK];
+    pNode->list.pNext        = pHead;
+    pNode->list.pPrev        = pHead->pPrev;
+    pHead->pPrev->pNext      = &pNode->list;
+    pHead->pPrev             = &pNode->list;
+}
+
+/*******************************************************************************
+ *  @brief  将某层某槽位中的定时器全部重新插入时间轮
+ *  @param  pTimer - 事件定时器指针
+ *          level  - 层
+ *          idx    - 槽位
+ *  @return void
+ */
+static void eventMatrix_TimerCascade(pEvTimer_t pTimer, int level, uint32_t idx) {
+    evTimerList_t   *pHead = &pTimer->wheel[level][idx];
+    evTimerList_t   *pEntry;
+
+    while ((pEntry = pHead->pNext) != pHead) {
+        eventMatrix_TimerListUnlink(pEntry);
+        eventMatrix_TimerInsert(pTimer, (pEvTimerNode_t)pEntry);
+    }
+}
+
+/*******************************************************************************
+ *  @brief  处理第0层某槽位中的到期定时器，设置事件标志，周期定时器重新插入，单次定时器回收
+ *  @param  pEcb - 事件控制块指针
+ *          idx  - 第0层槽位
+ *  @return void
+ */
+static void eventMatrix_TimerFire(pEcb_t pEcb, uint32_t idx) {
+    pEvTimer_t      pTimer = pEcb->pTimer;
+    evTimerList_t   *pHead = &pTimer->wheel[0][idx];
+    evTimerList_t   expired;
+    pEvTimerNode_t  pNode;
+
+    if (pHead->pNext == pHead) {
+        return;
+    }
+
+    expired.pNext           = pHead->pNext;                                     //整个槽位链表移出，避免周期定时器重新插入同一槽位
+    expired.pPrev           = pHead->pPrev;
+    expired.pNext->pPrev    = &expired;
+    expired.pPrev->pNext    = &expired;
+    eventMatrix_TimerListInit(pHead);
+
+    while (expired.pNext != &expired) {
+        pNode = (pEvTimerNode_t)expired.pNext;
+        eventMatrix_TimerListUnlink(&pNode->list);
+
+        if ((int32_t)(pNode->expire - pTimer->curTick) > 0) {                  //超出时间轮跨度的定时器尚未到期
+            eventMatrix_TimerInsert(pTimer, pNode);
+            continue;
+        }
+
+        eventMatrix_SetEventFlag(pEcb, pNode->eventFlag);
+
+        if (pNode->period != 0) {
+            pNode->expire += pNode->period;
+            eventMatrix_TimerInsert(pTimer, pNode);
+        } else {
+            pNode->active       = false;
+            pNode->list.pNext   = (evTimerList_t *)pTimer->pFreeList;
+            pTimer->pFreeList   = pNode;
+            pTimer->activeNum--;
+        }
+    }
+}
+
+/*******************************************************************************
+ *  @brief  初始化链表头
+ *  @param  pHead - 链表头指针
+ *  @return void
+ */
+static void eventMatrix_TimerListInit(evTimerList_t *pHead) {
+    pHead->pNext = pHead;
+    pHead->pPrev = pHead;
+}
+
+/*******************************************************************************
+ *  @brief  从链表中摘除结点
+ *  @param  pEntry - 结点指针
+ *  @return void
+ */
+static void eventMatrix_TimerListUnlink(evTimerList_t *pEntry) {
+    pEntry->pPrev->pNext = pEntry->pNext;
+    pEntry->pNext->pPrev = pEntry->pPrev;
+    pEntry->pNext = pEntry;
+    pEntry->pPrev = pEntry;
+}
+
+#endif /* EVENT_TIMER_ENABLE */
+
+/******************************** END OF FILE **********************************
+*************************** (C) Copyright 2019 REIZ ***************************/
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *  @file       reiz_eventMatrixTimer.h
+ *  @author     jxndsfss
+ *  @version    v1.0.0
+ *  @date       2026-10-19
+ *  @site       ShangYouSong.SZ
+ *  @brief      事件矩阵定时器头文件，分层时间轮实现延时事件及周期事件
+ *******************************************************************************
+ *  使用方法：
+ *  1.reiz_eventMatrix.h 中打开 EVENT_TIMER_ENABLE
+ *  2.定义定时器对象变量，节点数为同时存在的最大定时器数
+ *      例：static EVENT_TIMER_OBJ(1024) evTimerObj;
+ *  3.事件控制块初始化后初始化定时器，传入tick读取函数
+ *      例：eventMatrix_TimerInit(pEcb, &evTimerObj.timer, evTimerObj.nodeArr, 1024, getTickMs);
+ *  4.eventMatrix_SetEventFlagAfter() / eventMatrix_SetEventFlagPeriodic() 启动定时器
+ *  5.eventMatrix_EventProcess() 每次执行时推进时间轮，到期定时器设置对应事件标志
+ *******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef REIZ_EVENT_MATRIX_TIMER_H
+#define REIZ_EVENT_MATRIX_TIMER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "reiz_eventMatrix.h"
+
+#if EVENT_TIMER_ENABLE
+
+/* Exported define -----------------------------------------------------------*/
+
+/* 时间轮层数及每层槽位数位数，可表示最大延时为 2^(EVENT_TIMER_WHEEL_LEVEL * EVENT_TIMER_WHEEL_BITS) 个tick */
+#define EVENT_TIMER_WHEEL_LEVEL         4
+#define EVENT_TIMER_WHEEL_BITS          6
+
+/* 时间轮每层槽位数 */
+#define EVENT_TIMER_WHEEL_SLOT          (1 << EVENT_TIMER_WHEEL_BITS)
+
+/* Exported macro ------------------------------------------------------------*/
+
+/*
+    事件定时器对象宏类型定义
+    使用方法：
+    #define EVENT_TIMER_NUM  1024
+    EVENT_TIMER_OBJ(EVENT_TIMER_NUM) xxxEvTimerObj;
+*/
+#define EVENT_TIMER_OBJ(nodeNum)                                \
+struct {                                                        \
+    evTimer_t                           timer;                  \
+    evTimerNode_t                       nodeArr[nodeNum];       \
+}
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct evTimerList_ {                                                   //定时器双向链表结点类型定义
+    struct evTimerList_ *pNext;
+    struct evTimerList_ *pPrev;
+} evTimerList_t;
+
+typedef struct evTimerNode_ {                                                   //定时器节点类型定义
+    evTimerList_t       list;                                                   //时间轮槽位链表结点，必须为第一个成员
+    uint32_t            expire;                                                 //到期tick
+    uint32_t            period;                                                 //周期tick，0为单次定时器
+    int                 eventFlag;                                              //到期时设置的事件标志
+    bool                active;                                                 //定时器运行中
+} evTimerNode_t, *pEvTimerNode_t;
+
+typedef struct evTimer_ {                                                       //事件定时器分层时间轮类型定义
+    evTimerList_t       wheel[EVENT_TIMER_WHEEL_LEVEL][EVENT_TIMER_WHEEL_SLOT]; //各层槽位链表头
+    evTimerNode_t       *pFreeList;                                             //空闲节点链表
+    pEvGetTick_t        pGetTick;                                               //tick读取函数指针
+    uint32_t            curTick;                                                //时间轮下一个待处理tick
+    uint32_t            activeNum;                                              //运行中定时器数目
+} evTimer_t, *pEvTimer_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+extern bool eventMatrix_TimerInit(  pEcb_t              pEcb,                   //事件定时器初始化
+                                    pEvTimer_t          pTimer,
+                                    evTimerNode_t       *pNodeArr,
+                                    int                 nodeNum,
+                                    pEvGetTick_t        pGetTick);
+
+extern pEvTimerNode_t eventMatrix_SetEventFlagAfter(pEcb_t pEcb, int eventFlag, uint32_t delay);   //延时delay个tick后设置事件标志
+extern pEvTimerNode_t eventMatrix_SetEventFlagPeriodic( pEcb_t pEcb,                               //延时delay个tick后以period为周期设置事件标志
+                                                        int eventFlag,
+                                                        uint32_t delay,
+                                                        uint32_t period);
+extern bool eventMatrix_TimerCancel(pEcb_t pEcb, pEvTimerNode_t pNode);         //取消定时器
+extern void eventMatrix_TimerAdvance(pEcb_t pEcb);                              //推进时间轮至当前tick，设置到期事件标志
+extern int  eventMatrix_TimerNextTimeout(pEcb_t pEcb);                          //读取距离下次需推进时间轮的tick数，-1为无运行中定时器
+
+#endif /* EVENT_TIMER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REIZ_EVENT_MATRIX_TIMER_H */
+
+/******************************** END OF FILE **********************************
+*************************** (C) Copyright 2019 REIZ ***************************/
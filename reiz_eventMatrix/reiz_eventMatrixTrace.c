@@ -0,0 +1,493 @@
+/*******************************************************************************
+ *  @file       reiz_eventMatrixTrace.c
+ *  @author     jxndsfss
+ *  @version    v1.0.0
+ *  @date       2026-10-19
+ *  @site       ShangYouSong.SZ
+ *  @brief      事件矩阵跟踪记录源文件，记录事件设置/参数保存/事件处理并离线回放
+ *******************************************************************************
+ */
+
+/*******************************************************************************
+ *  @algorithm  每个线程首次记录时分配一个单生产者单消费者环形缓冲区，并无锁插入全局缓冲区链表；
+ *              记录线程只写本线程缓冲区写索引，刷新线程只写读索引，二者以 acquire/release 同步；
+ *              刷新时逐个缓冲区顺序写入文件，故文件中记录仅线程内有序，回放前按时间排序；
+ *              回放状态经全局指针原子占用保证同一时刻仅一个回放，延时统计仅由回放线程经本线程指针写入
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "reiz_eventMatrixTrace.h"
+
+#if EVENT_TRACE_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Private define ------------------------------------------------------------*/
+
+#define EVENT_TRACE_RING_MASK           (EVENT_TRACE_RING_SIZE - 1)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private typedef -----------------------------------------------------------*/
+typedef struct evTraceRing_ {                                                   //每线程跟踪记录环形缓冲区类型定义
+    struct evTraceRing_ *pNext;                                                 //全局缓冲区链表下一结点
+    uint32_t            head;                                                   //写索引，仅记录线程修改
+    uint32_t            tail;                                                   //读索引，仅刷新线程修改
+    uint32_t            dropTimes;                                              //缓冲区满或事件标志超出记录范围丢弃记录次数
+    uint64_t            lastNs;                                                 //上条记录时间，保证线程内记录时间严格递增
+    evTraceRec_t        recBuf[EVENT_TRACE_RING_SIZE];
+} evTraceRing_t;
+
+typedef struct evTraceReplay_ {                                                 //回放状态类型定义
+    uint64_t            *pPostNs;                                               //各事件待分发时设置时间，0为无待分发
+    uint8_t             *pParaPend;                                             //各事件有回放参数待分发
+    int                 eventNum;
+    uint32_t            *pLatArr;                                               //设置至分发延时样本
+    uint32_t            latNum;
+    uint32_t            latCap;
+} evTraceReplay_t;
+
+/* Private variables ---------------------------------------------------------*/
+static evTraceRing_t            *pEvTraceRingList   = NULL;                     //全局缓冲区链表，只增不减
+static __thread evTraceRing_t   *pEvTraceRingLocal  = NULL;                     //本线程缓冲区
+static int                      evTraceOn           = 0;                        //记录开关
+static FILE                     *pEvTraceFile       = NULL;
+static evTraceReplay_t          *pEvTraceReplay     = NULL;                     //回放进行中时非空，原子读写
+static __thread evTraceReplay_t *pEvTraceReplayLocal = NULL;                    //本线程为回放线程时指向回放状态
+
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint64_t eventMatrix_TraceNowNs(void);
+static evTraceRing_t *eventMatrix_TraceRingGet(void);
+static void eventMatrix_TraceReplayRecord(int type, int eventFlag);
+static void eventMatrix_TraceReplayPara(pEcb_t pEcb, int eventFlag, uint32_t paraSize);
+static void eventMatrix_TraceReplayWait(uint64_t targetNs);
+static int  eventMatrix_TraceRecCmp(const void *pA, const void *pB);
+static int  eventMatrix_TraceLatCmp(const void *pA, const void *pB);
+
+/*******************************************************************************
+ *  @brief  打开跟踪文件并开始记录
+ *  @param  pPath - 跟踪文件路径
+ *  @return true  - 打开成功
+ *          false - 打开失败
+ */
+extern bool eventMatrix_TraceOpen(const char *pPath) {
+    evTraceFileHead_t head;
+
+    if (pPath == NULL || pEvTraceFile != NULL) {
+        return false;
+    }
+
+    pEvTraceFile = fopen(pPath, "wb");
+    if (pEvTraceFile == NULL) {
+        return false;
+    }
+
+    head.magic      =   EV_TRACE_FILE_MAGIC;
+    head.version    =   EV_TRACE_FILE_VERSION;
+    head.recSize    =   sizeof(evTraceRec_t);
+    if (fwrite(&head, sizeof(head), 1, pEvTraceFile) != 1) {
+        fclose(pEvTraceFile);
+        pEvTraceFile = NULL;
+        return false;
+    }
+
+    __atomic_store_n(&evTraceOn, 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  将各线程缓冲区记录写入跟踪文件，同一时刻只能有一个线程调用
+ *  @param  void
+ *  @return 写入记录数，-1为跟踪文件未打开或写入失败
+ */
+extern int eventMatrix_TraceFlush(void) {
+    evTraceRing_t   *pRing;
+    uint32_t        head, tail, idx, len;
+    int             recNum = 0;
+
+    if (pEvTraceFile == NULL) {
+        return -1;
+    }
+
+    for (pRing = __atomic_load_n(&pEvTraceRingList, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext) {
+        head = __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+        tail = pRing->tail;
+
+        while (tail != head) {                                                  //缓冲区回绕时分两段写入
+            idx = tail & EVENT_TRACE_RING_MASK;
+            len = head - tail;
+            if (len > EVENT_TRACE_RING_SIZE - idx) {
+                len = EVENT_TRACE_RING_SIZE - idx;
+            }
+            if (fwrite(&pRing->recBuf[idx], sizeof(evTraceRec_t), len, pEvTraceFile) != len) {
+                return -1;
+            }
+            tail += len;
+            recNum += len;
+        }
+        __atomic_store_n(&pRing->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    fflush(pEvTraceFile);
+    return recNum;
+}
+
+/*******************************************************************************
+ *  @brief  停止记录，写入剩余记录并关闭跟踪文件
+ *          各线程缓冲区保留至进程结束，以免记录线程仍持有其指针
+ *  @param  void
+ *  @return void
+ */
+extern void eventMatrix_TraceClose(void) {
+    if (pEvTraceFile == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&evTraceOn, 0, __ATOMIC_RELEASE);
+    eventMatrix_TraceFlush();
+    fclose(pEvTraceFile);
+    pEvTraceFile = NULL;
+}
+
+/*******************************************************************************
+ *  @brief  读取缓冲区满丢弃记录次数
+ *  @param  void
+ *  @return 各线程缓冲区满或事件标志超出记录范围丢弃记录次数之和
+ */
+extern uint32_t eventMatrix_TraceDropTimes(void) {
+    evTraceRing_t   *pRing;
+    uint32_t        dropTimes = 0;
+
+    for (pRing = __atomic_load_n(&pEvTraceRingList, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext) {
+        dropTimes += __atomic_load_n(&pRing->dropTimes, __ATOMIC_RELAXED);
+    }
+    return dropTimes;
+}
+
+/*******************************************************************************
+ *  @brief  写入一条跟踪记录，由事件矩阵调用，未开始记录时直接返回
+ *          回放中不记录，回放线程统计延时，其他线程的记录忽略
+ *          事件标志超出 EV_TRACE_ID_MAX 记录范围时不记录，计入丢弃次数，避免回放至错误事件
+ *  @param  type      - 记录类型
+ *          eventFlag - 事件标志
+ *          paraSize  - 事件参数大小
+ *  @return void
+ */
+extern void eventMatrix_TraceRecord(int type, int eventFlag, uint32_t paraSize) {
+    evTraceRing_t   *pRing;
+    evTraceRec_t    *pRec;
+    uint32_t        head;
+
+    if (pEvTraceReplayLocal != NULL) {                                          //回放线程仅统计延时
+        eventMatrix_TraceReplayRecord(type, eventFlag);
+        return;
+    }
+
+    if (__atomic_load_n(&pEvTraceReplay, __ATOMIC_ACQUIRE) != NULL) {           //回放中其他线程不记录
+        return;
+    }
+
+    if (!__atomic_load_n(&evTraceOn, __ATOMIC_RELAXED) || (pRing = eventMatrix_TraceRingGet()) == NULL) {
+        return;
+    }
+
+    head = pRing->head;
+    if ((uint32_t)eventFlag >= EV_TRACE_ID_MAX ||                               //事件标志超出记录范围，截断后将回放至错误事件
+        head - __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE) >= EVENT_TRACE_RING_SIZE) {
+        __atomic_store_n(&pRing->dropTimes, pRing->dropTimes + 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    pRec = &pRing->recBuf[head & EVENT_TRACE_RING_MASK];
+    pRec->timeNs    =   eventMatrix_TraceNowNs();
+    if (pRec->timeNs <= pRing->lastNs) {                                        //时钟分辨率不足时顺延，回放排序后保持线程内顺序
+        pRec->timeNs = pRing->lastNs + 1;
+    }
+    pRing->lastNs   =   pRec->timeNs;
+    pRec->idType    =   EV_TRACE_ID_TYPE(type, eventFlag);
+    pRec->paraSize  =   paraSize;
+    __atomic_store_n(&pRing->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/*******************************************************************************
+ *  @brief  回放跟踪文件，事件控制块需已初始化并注册回调函数，超出事件矩阵范围的记录跳过
+ *          保存事件参数记录按记录大小分配清零内存作为参数，由事件矩阵在分发后释放
+ *  @param  pEcb    - 事件控制块指针
+ *          pPath   - 跟踪文件路径
+ *          speed   - 回放速度，0为尽快回放，1为按记录时间回放，n为n倍速回放
+ *          pReport - 回放结果存储指针
+ *  @return true    - 回放成功
+ *          false   - 回放失败
+ */
+extern bool eventMatrix_TraceReplay(pEcb_t              pEcb,
+                                    const char          *pPath,
+                                    uint32_t            speed,
+                                    pEvTraceReport_t    pReport)
+{
+    FILE                *pFile;
+    evTraceFileHead_t   head;
+    evTraceRec_t        *pRecArr = NULL, *pArr;
+    evTraceReplay_t     replay;
+    evTraceReplay_t     *pIdle = NULL;
+    uint32_t            recNum = 0, recCap = 0, i;
+    uint64_t            startNs, baseNs;
+    int                 type, eventFlag;
+    bool                ok = false;
+
+    if (pEcb == NULL || pPath == NULL || pReport == NULL) {
+        return false;
+    }
+
+    memset(&replay, 0, sizeof(replay));
+    if (!__atomic_compare_exchange_n(&pEvTraceReplay, &pIdle, &replay,          //占用回放状态，同一时刻仅一个回放
+                                     false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        return false;
+    }
+
+    pFile = fopen(pPath, "rb");
+    if (pFile == NULL) {
+        goto exit;
+    }
+
+    if (fread(&head, sizeof(head), 1, pFile) != 1 || head.magic != EV_TRACE_FILE_MAGIC ||
+        head.version != EV_TRACE_FILE_VERSION || head.recSize != sizeof(evTraceRec_t)) {
+        fclose(pFile);
+        goto exit;
+    }
+
+    for (;;) {                                                                  //读入全部记录
+        if (recNum == recCap) {
+            recCap = recCap ? recCap * 2 : 4096;
+            pArr = (evTraceRec_t *)realloc(pRecArr, recCap * sizeof(evTraceRec_t));
+            if (pArr == NULL) {
+                fclose(pFile);
+                goto exit;
+            }
+            pRecArr = pArr;
+        }
+        if (fread(&pRecArr[recNum], sizeof(evTraceRec_t), 1, pFile) != 1) {
+            break;
+        }
+        recNum++;
+    }
+    fclose(pFile);
+
+    qsort(pRecArr, recNum, sizeof(evTraceRec_t), eventMatrix_TraceRecCmp);     //各线程记录按时间合并
+
+    replay.eventNum = pEcb->matrixRow * EVENT_MATRIX_COL;
+    replay.pPostNs = (uint64_t *)calloc(replay.eventNum, sizeof(uint64_t));
+    replay.pParaPend = (uint8_t *)calloc(replay.eventNum, sizeof(uint8_t));
+    if (replay.pPostNs == NULL || replay.pParaPend == NULL) {
+        goto exit;
+    }
+
+    memset(pReport, 0, sizeof(evTraceReport_t));
+    pEvTraceReplayLocal = &replay;
+    baseNs = recNum ? pRecArr[0].timeNs : 0;
+    startNs = eventMatrix_TraceNowNs();
+
+    for (i = 0; i < recNum; i++) {
+        type = EV_TRACE_REC_TYPE(&pRecArr[i]);
+        eventFlag = EV_TRACE_REC_ID(&pRecArr[i]);
+
+        if (type == EV_TRACE_TYPE_DISPATCH || (type != EV_TRACE_TYPE_PROCESS && eventFlag >= replay.eventNum)) {
+            continue;                                                           //分发记录由回放重新产生
+        }
+
+        if (speed != 0) {
+            eventMatrix_TraceReplayWait(startNs + (pRecArr[i].timeNs - baseNs) / speed);
+        }
+
+        if (type == EV_TRACE_TYPE_SET) {
+            eventMatrix_SetEventFlag(pEcb, eventFlag);
+            pReport->postNum++;
+        } else if (type == EV_TRACE_TYPE_PARA) {
+            eventMatrix_TraceReplayPara(pEcb, eventFlag, pRecArr[i].paraSize);
+            pReport->postNum++;
+        } else if (type == EV_TRACE_TYPE_PROCESS) {
+            eventMatrix_EventProcess(pEcb);
+        }
+        pReport->recNum++;
+    }
+    eventMatrix_EventProcess(pEcb);                                             //处理末次事件处理后设置的事件
+
+    pReport->elapsedNs = eventMatrix_TraceNowNs() - startNs;
+    pEvTraceReplayLocal = NULL;
+
+    pReport->dispatchNum = replay.latNum;
+    if (pReport->elapsedNs != 0) {
+        pReport->throughput = (double)replay.latNum * 1e9 / (double)pReport->elapsedNs;
+    }
+    if (replay.latNum != 0) {
+        qsort(replay.pLatArr, replay.latNum, sizeof(uint32_t), eventMatrix_TraceLatCmp);
+        pReport->latP50     =   replay.pLatArr[(uint64_t)replay.latNum * 50 / 100];
+        pReport->latP90     =   replay.pLatArr[(uint64_t)replay.latNum * 90 / 100];
+        pReport->latP99     =   replay.pLatArr[(uint64_t)replay.latNum * 99 / 100];
+        pReport->latP999    =   replay.pLatArr[(uint64_t)replay.latNum * 999 / 1000];
+        pReport->latMax     =   replay.pLatArr[replay.latNum - 1];
+    }
+    ok = true;
+
+exit:
+    pEvTraceReplayLocal = NULL;
+    __atomic_store_n(&pEvTraceReplay, NULL, __ATOMIC_RELEASE);
+    free(replay.pLatArr);
+    free(replay.pPostNs);
+    free(replay.pParaPend);
+    free(pRecArr);
+    return ok;
+}
+
+/*******************************************************************************
+ *  @brief  读取单调时钟纳秒
+ *  @param  void
+ *  @return 当前时间
+ */
+static uint64_t eventMatrix_TraceNowNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+ *  @brief  获取本线程缓冲区，首次调用时分配并插入全局缓冲区链表
+ *  @param  void
+ *  @return 本线程缓冲区指针，分配失败返回NULL
+ */
+static evTraceRing_t *eventMatrix_TraceRingGet(void) {
+    evTraceRing_t *pRing = pEvTraceRingLocal;
+
+    if (pRing != NULL) {
+        return pRing;
+    }
+
+    pRing = (evTraceRing_t *)calloc(1, sizeof(evTraceRing_t));
+    if (pRing == NULL) {
+        return NULL;
+    }
+
+    pRing->pNext = __atomic_load_n(&pEvTraceRingList, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&pEvTraceRingList, &pRing->pNext, pRing,
+                                        false, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    pEvTraceRingLocal = pRing;
+    return pRing;
+}
+
+/*******************************************************************************
+ *  @brief  回放中统计设置至分发延时，延时自事件待分发期间首次设置起算
+ *  @param  type      - 记录类型
+ *          eventFlag - 事件标志
+ *  @return void
+ */
+static void eventMatrix_TraceReplayRecord(int type, int eventFlag) {
+    evTraceReplay_t *pReplay = pEvTraceReplayLocal;
+    uint64_t        now, lat;
+
+    if (eventFlag < 0 || eventFlag >= pReplay->eventNum) {
+        return;
+    }
+
+    if (type == EV_TRACE_TYPE_SET || type == EV_TRACE_TYPE_PARA) {
+        if (pReplay->pPostNs[eventFlag] == 0) {
+            pReplay->pPostNs[eventFlag] = eventMatrix_TraceNowNs();
+        }
+    } else if (type == EV_TRACE_TYPE_DISPATCH) {
+        now = eventMatrix_TraceNowNs();
+        lat = pReplay->pPostNs[eventFlag] ? now - pReplay->pPostNs[eventFlag] : 0;
+        pReplay->pPostNs[eventFlag] = 0;
+        pReplay->pParaPend[eventFlag] = 0;
+
+        if (pReplay->latNum == pReplay->latCap) {
+            uint32_t cap = pReplay->latCap ? pReplay->latCap * 2 : 4096;
+            uint32_t *pArr = (uint32_t *)realloc(pReplay->pLatArr, cap * sizeof(uint32_t));
+
+            if (pArr == NULL) {
+                return;
+            }
+            pReplay->pLatArr = pArr;
+            pReplay->latCap = cap;
+        }
+        pReplay->pLatArr[pReplay->latNum++] = lat > UINT32_MAX ? UINT32_MAX : (uint32_t)lat;
+    }
+}
+
+/*******************************************************************************
+ *  @brief  回放保存事件参数，保存失败时释放参数内存
+ *          未使能参数队列时，上次保存的参数尚未分发则丢弃本次参数，避免覆盖泄漏
+ *  @param  pEcb      - 事件控制块指针
+ *          eventFlag - 事件标志
+ *          paraSize  - 事件参数大小
+ *  @return void
+ */
+static void eventMatrix_TraceReplayPara(pEcb_t pEcb, int eventFlag, uint32_t paraSize) {
+    void *pPara;
+
+#if !EVENT_PARA_QUEUE_ENABLE
+    if (pEvTraceReplayLocal->pParaPend[eventFlag]) {
+        return;
+    }
+#endif
+
+    pPara = calloc(1, paraSize ? paraSize : 1);
+    if (pPara == NULL) {
+        return;
+    }
+
+    if (eventMatrix_SaveEventParaSz(pEcb, eventFlag, pPara, paraSize)) {
+        pEvTraceReplayLocal->pParaPend[eventFlag] = 1;
+    } else {
+        free(pPara);
+    }
+}
+
+/*******************************************************************************
+ *  @brief  回放等待至目标时间，剩余时间较长时睡眠，较短时忙等
+ *  @param  targetNs - 目标时间
+ *  @return void
+ */
+static void eventMatrix_TraceReplayWait(uint64_t targetNs) {
+    struct timespec ts;
+    uint64_t        now;
+
+    while ((now = eventMatrix_TraceNowNs()) < targetNs) {
+        if (targetNs - now > 200000) {
+            ts.tv_sec  = 0;
+            ts.tv_nsec = (long)(targetNs - now - 100000);
+            if (ts.tv_nsec >= 1000000000) {
+                ts.tv_sec  = ts.tv_nsec / 1000000000;
+                ts.tv_nsec = ts.tv_nsec % 1000000000;
+            }
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+/*******************************************************************************
+ *  @brief  跟踪记录按时间比较
+ */
+static int eventMatrix_TraceRecCmp(const void *pA, const void *pB) {
+    uint64_t a = ((const evTraceRec_t *)pA)->timeNs;
+    uint64_t b = ((const evTraceRec_t *)pB)->timeNs;
+
+    return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+ *  @brief  延时样本比较
+ */
+static int eventMatrix_TraceLatCmp(const void *pA, const void *pB) {
+    uint32_t a = *(const uint32_t *)pA;
+    uint32_t b = *(const uint32_t *)pB;
+
+    return (a > b) - (a < b);
+}
+
+#endif /* EVENT_TRACE_ENABLE */
+
+/******************************** END OF FILE **********************************
+*************************** (C) Copyright 2019 REIZ ***************************/
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *  @file       reiz_eventMatrixTrace.h
+ *  @author     jxndsfss
+ *  @version    v1.0.0
+ *  @date       2026-10-19
+ *  @site       ShangYouSong.SZ
+ *  @brief      事件矩阵跟踪记录头文件，记录事件设置/参数保存/事件处理并离线回放
+ *******************************************************************************
+ *  使用方法：
+ *  1.reiz_eventMatrix.h 中打开 EVENT_TRACE_ENABLE
+ *  2.eventMatrix_TraceOpen("ev.trace") 开始记录，各线程记录写入本线程无锁环形缓冲区
+ *  3.周期调用 eventMatrix_TraceFlush() 将缓冲区记录写入文件，缓冲区满时丢弃记录并计数
+ *  4.eventMatrix_TraceClose() 停止记录并关闭文件
+ *  5.离线回放：初始化事件控制块并注册回调函数后调用
+ *      eventMatrix_TraceReplay(pEcb, "ev.trace", 1, &report);
+ *    按记录时间重新设置事件标志及参数，于记录的事件处理时刻调用事件处理函数，
+ *    统计吞吐量及设置至分发延时分位数
+ *******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef REIZ_EVENT_MATRIX_TRACE_H
+#define REIZ_EVENT_MATRIX_TRACE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "reiz_eventMatrix.h"
+
+#if EVENT_TRACE_ENABLE
+
+/* Exported define -----------------------------------------------------------*/
+
+/* 每线程跟踪记录环形缓冲区容量，必须为2的幂 */
+#define EVENT_TRACE_RING_SIZE           4096
+
+#if (EVENT_TRACE_RING_SIZE & (EVENT_TRACE_RING_SIZE - 1)) != 0
+#error "EVENT_TRACE_RING_SIZE must be a power of 2"
+#endif
+
+/* 跟踪记录类型 */
+#define EV_TRACE_TYPE_SET               1                                       //设置事件标志
+#define EV_TRACE_TYPE_PARA              2                                       //保存事件参数
+#define EV_TRACE_TYPE_PROCESS           3                                       //调用事件处理函数
+#define EV_TRACE_TYPE_DISPATCH          4                                       //分发事件至回调函数
+
+/* 跟踪文件头标识及版本 */
+#define EV_TRACE_FILE_MAGIC             0x52545645u                             //"EVTR"
+#define EV_TRACE_FILE_VERSION           1
+
+/* 跟踪记录可记录的事件标志上限，事件标志占记录低24位，不小于该值的事件标志不记录并计入丢弃次数 */
+#define EV_TRACE_ID_MAX                 (1u << 24)
+
+/* Exported macro ------------------------------------------------------------*/
+
+/* 跟踪记录类型及事件标志打包，高8位为类型，低24位为事件标志 */
+#define EV_TRACE_ID_TYPE(type, eventFlag)   (((uint32_t)(type) << 24) | ((uint32_t)(eventFlag) & (EV_TRACE_ID_MAX - 1)))
+#define EV_TRACE_REC_TYPE(pRec)             ((pRec)->idType >> 24)
+#define EV_TRACE_REC_ID(pRec)               ((int)((pRec)->idType & (EV_TRACE_ID_MAX - 1)))
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct evTraceRec_ {                                                    //跟踪记录类型定义，16字节
+    uint64_t            timeNs;                                                 //记录时间，单调时钟纳秒
+    uint32_t            idType;                                                 //记录类型及事件标志
+    uint32_t            paraSize;                                               //事件参数大小，仅保存事件参数记录有效
+} evTraceRec_t, *pEvTraceRec_t;
+
+typedef struct evTraceFileHead_ {                                               //跟踪文件头类型定义
+    uint32_t            magic;
+    uint16_t            version;
+    uint16_t            recSize;
+} evTraceFileHead_t;
+
+typedef struct evTraceReport_ {                                                 //回放结果类型定义，时间单位为纳秒
+    uint32_t            recNum;                                                 //回放记录数
+    uint32_t            postNum;                                                //设置事件标志及保存事件参数次数
+    uint32_t            dispatchNum;                                            //分发事件次数
+    uint64_t            elapsedNs;                                              //回放耗时
+    double              throughput;                                             //每秒分发事件次数
+    uint32_t            latP50;                                                 //设置至分发延时分位数
+    uint32_t            latP90;
+    uint32_t            latP99;
+    uint32_t            latP999;
+    uint32_t            latMax;
+} evTraceReport_t, *pEvTraceReport_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+extern bool     eventMatrix_TraceOpen(const char *pPath);                       //打开跟踪文件并开始记录
+extern int      eventMatrix_TraceFlush(void);                                   //将各线程缓冲区记录写入跟踪文件，返回写入记录数
+extern void     eventMatrix_TraceClose(void);                                   //停止记录，写入剩余记录并关闭跟踪文件
+extern uint32_t eventMatrix_TraceDropTimes(void);                               //读取缓冲区满或事件标志超出记录范围丢弃记录次数
+extern void     eventMatrix_TraceRecord(int type, int eventFlag, uint32_t paraSize);  //写入一条跟踪记录，由事件矩阵调用
+
+extern bool eventMatrix_TraceReplay(pEcb_t              pEcb,                   //回放跟踪文件
+                                    const char          *pPath,
+                                    uint32_t            speed,
+                                    pEvTraceReport_t    pReport);
+
+#endif /* EVENT_TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REIZ_EVENT_MATRIX_TRACE_H */
+
+/******************************** END OF FILE **********************************
+*************************** (C) Copyright 2019 REIZ ***************************/
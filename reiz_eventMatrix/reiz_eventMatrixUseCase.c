@@ -24,6 +24,10 @@
 /* Includes ------------------------------------------------------------------*/
 #include "reiz_eventMatrix.h"
 #include <stdio.h>
+#include <time.h>
+#if EVENT_SHARD_ENABLE
+#include <pthread.h>
+#endif
 
 /* Private define ------------------------------------------------------------*/
 
@@ -56,18 +60,56 @@
 #define PRINT_18_EVENT_FLAG     18
 #define PRINT_19_EVENT_FLAG     19
 
+/* 分发基准测试参数：事件矩阵行数、随机注册事件数、每次事件处理前随机设置事件数、事件处理次数 */
+#define EVENT_BENCH_ROW         640
+#define EVENT_BENCH_REG_NUM     2000
+#define EVENT_BENCH_FIRE_NUM    16
+#define EVENT_BENCH_PASS_NUM    20000
+
+/* 分片基准测试参数：事件矩阵行数、最大设置线程数、每线程设置事件标志次数 */
+#define EVENT_SHARD_BENCH_ROW       4
+#define EVENT_SHARD_BENCH_THREAD    32
+#define EVENT_SHARD_BENCH_POST_NUM  200000
+
+/* 参数回收基准测试参数：每遍事件处理的事件数、事件处理次数、参数大小上限 */
+#define EVENT_RECLAIM_BENCH_EVENT_NUM   256
+#define EVENT_RECLAIM_BENCH_PASS_NUM    2000
+#define EVENT_RECLAIM_BENCH_PARA_MAX    8192
+
 /* Private macro -------------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
 
 static ecb_t ecb;                                                               //事件控制块变量定义
-static EVENT_PROCESS_OBJ(EVENT_MATRIX_ROW) evProcessObj;                        //事件处理对象变量定义
+#if !EVENT_MATRIX_DYNAMIC_ENABLE
+static EVENT_PROCESS_OBJ(EVENT_MATRIX_ROW) evProcessObj;                        //事件处理对象变量定义，动态矩阵由初始化函数分配
+#endif
 
 /* Exported variables --------------------------------------------------------*/
 
 extern pEcb_t  pEcb = &ecb;                                                     //事件控制块指针变量定义
 
+static ecb_t benchEcb;                                                          //分发基准测试事件控制块
+static EVENT_PROCESS_OBJ(EVENT_BENCH_ROW) benchObj;                             //分发基准测试事件处理对象
+static uint32_t benchHits;                                                      //分发基准测试回调函数执行次数
+
+#if EVENT_SHARD_ENABLE
+static ecb_t shardBenchEcb;                                                     //分片基准测试事件控制块
+#if !EVENT_MATRIX_DYNAMIC_ENABLE
+static EVENT_PROCESS_OBJ(EVENT_SHARD_BENCH_ROW) shardBenchObj;                  //分片基准测试事件处理对象
+#endif
+static EVENT_SHARD_OBJ(EVENT_SHARD_BENCH_ROW, EVENT_SHARD_BENCH_THREAD) shardBenchShardObj; //分片基准测试事件标志分片对象
+static int shardBenchDoneNum;                                                   //分片基准测试已完成设置线程数
+#endif
+
+#if EVENT_RECLAIM_ENABLE
+static evReclaimer_t reclaimBenchReclaimer;                                     //参数回收基准测试后台回收线程
+static struct timespec reclaimBenchPassBegin;                                   //参数回收基准测试本遍事件处理开始时间
+static uint32_t *pReclaimBenchLat;                                              //参数回收基准测试分发延时数组，单位ns
+static uint32_t reclaimBenchLatNum;                                             //参数回收基准测试分发延时个数
+#endif
+
 /* Private function prototypes -----------------------------------------------*/
 
 //事件回调函数声明
@@ -92,6 +134,17 @@ static void event_16_handleCb(void *pPara);
 static void event_17_handleCb(void *pPara);
 static void event_18_handleCb(void *pPara);
 static void event_19_handleCb(void *pPara);
+static void eventBench_handleCb(void *pPara);
+static bool eventBenchInit(pEcb_t pBenchEcb);
+#if EVENT_SHARD_ENABLE
+static double eventShardBenchRun(int threadNum, bool shard);
+static void *eventShardBench_postThread(void *pArg);
+#endif
+#if EVENT_RECLAIM_ENABLE
+static void eventReclaimBenchRun(int mode);
+static void eventReclaimBench_handleCb(void *pPara);
+static int eventReclaimBench_cmpLat(const void *pA, const void *pB);
+#endif
 
 
 static void registAllEventHandleCB(void) {
@@ -472,11 +525,31 @@ extern void setAllEventFlag(void) {
  *  @return void
  */
 extern void evProcessInit(void) {
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbDynInit(pEcb, EVENT_MATRIX_ROW);                             //优先级类、使能掩码矩阵随之分配
+#elif EVENT_MATRIX_SPARSE_ENABLE
+    eventMatrix_ecbSparseInit(  pEcb,
+                                EVENT_MATRIX_ROW,
+                                (pEvFlagMatrix_t)evProcessObj.evFlagMatrix,
+                                (pEvSparseMatrix_t)evProcessObj.evSparseMatrix);
+#elif EVENT_MATRIX_AOS_ENABLE
+    eventMatrix_ecbSlotInit(pEcb,
+                            EVENT_MATRIX_ROW,
+                            (pEvFlagMatrix_t)evProcessObj.evFlagMatrix,
+                            (pEvSlotMatrix_t)evProcessObj.evSlotMatrix);
+#else
     eventMatrix_ecbInit(pEcb,
                         EVENT_MATRIX_ROW,
                         (pEvFlagMatrix_t)evProcessObj.evFlagMatrix,
                         (pEvCbMatrix_t)evProcessObj.evCbMatrix,
                         (pEvParaMatrix_t)evProcessObj.evParaMatrix);
+#endif
+#if EVENT_PRIORITY_ENABLE && !EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbPrioInit(pEcb, (pEvPrioMatrix_t)evProcessObj.evPrioMatrix);
+#endif
+#if EVENT_ENABLE_MASK_ENABLE && !EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbEnableInit(pEcb, (pEvFlagMatrix_t)evProcessObj.evEnableMatrix);
+#endif
     registAllEventHandleCB();
 }
 
@@ -491,5 +564,319 @@ extern void eventProcessTest(void) {
     eventMatrix_EventProcess(pEcb);
 }
 
+/*******************************************************************************
+ *  @brief  事件分发基准测试函数，随机注册稀疏事件并随机设置事件标志，
+ *          统计每次事件处理耗时，用于比较 EVENT_MATRIX_SPARSE_ENABLE / EVENT_MATRIX_AOS_ENABLE
+ *          及默认分离矩阵存储方式，分别编译运行后比较输出
+ *  @param  void
+ *  @return void
+ */
+extern void eventDispatchBenchmark(void) {
+    static int regArr[EVENT_BENCH_REG_NUM];
+    uint32_t seed = 12345;
+    clock_t begin, end;
+    int i, j;
+
+    if (!eventBenchInit(&benchEcb)) {
+        return;
+    }
+
+    for (i = 0; i < EVENT_BENCH_REG_NUM; i++) {                                 //线性同余随机数，保证各存储方式事件序列相同
+        seed = seed * 1103515245 + 12345;
+        regArr[i] = (seed >> 8) % (EVENT_BENCH_ROW * EVENT_MATRIX_COL);
+        eventMatrix_RegistEvCB(&benchEcb, regArr[i], eventBench_handleCb);
+    }
+
+    benchHits = 0;
+    begin = clock();
+    for (i = 0; i < EVENT_BENCH_PASS_NUM; i++) {
+        for (j = 0; j < EVENT_BENCH_FIRE_NUM; j++) {
+            seed = seed * 1103515245 + 12345;
+            eventMatrix_SetEventFlag(&benchEcb, regArr[(seed >> 8) % EVENT_BENCH_REG_NUM]);
+        }
+        eventMatrix_EventProcess(&benchEcb);
+    }
+    end = clock();
+
+    printf("layout: %s, object size: %u bytes, dispatch: %u, %.1f ns/pass\n",
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+           "dynamic",
+#elif EVENT_MATRIX_SPARSE_ENABLE
+           "sparse",
+#elif EVENT_MATRIX_AOS_ENABLE
+           "slot",
+#else
+           "split",
+#endif
+           (unsigned)sizeof(benchObj), (unsigned)benchHits,
+           (double)(end - begin) * 1e9 / CLOCKS_PER_SEC / EVENT_BENCH_PASS_NUM);
+
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbDynDeinit(&benchEcb);
+#elif EVENT_MATRIX_SPARSE_ENABLE
+    eventMatrix_ecbSparseDeinit(&benchEcb);
+#endif
+}
+
+#if EVENT_SHARD_ENABLE
+/*******************************************************************************
+ *  @brief  分片设置事件标志基准测试函数，1~32个线程同时设置事件标志，主线程同时执行事件处理，
+ *          分别统计所有线程共享事件标志矩阵及各线程写私有分片时每秒设置事件标志次数
+ *  @param  void
+ *  @return void
+ */
+extern void eventShardBenchmark(void) {
+    double shareRate, shardRate;
+    int threadNum;
+
+    for (threadNum = 1; threadNum <= EVENT_SHARD_BENCH_THREAD; threadNum *= 2) {
+        shareRate = eventShardBenchRun(threadNum, false);
+        shardRate = eventShardBenchRun(threadNum, true);
+        printf("threads: %2d, shared: %7.2f Mpost/s, sharded: %7.2f Mpost/s\n",
+               threadNum, shareRate / 1e6, shardRate / 1e6);
+    }
+}
+
+/*******************************************************************************
+ *  @brief  执行一轮分片基准测试
+ *  @param  threadNum - 设置事件标志线程数
+ *          shard     - true 各线程写私有分片，false 共享事件标志矩阵
+ *  @return 每秒设置事件标志次数，失败返回0
+ */
+static double eventShardBenchRun(int threadNum, bool shard) {
+    pthread_t threadArr[EVENT_SHARD_BENCH_THREAD];
+    struct timespec begin, end;
+    int i, createNum;
+
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbDynInit(&shardBenchEcb, EVENT_SHARD_BENCH_ROW);
+#elif EVENT_MATRIX_SPARSE_ENABLE
+    eventMatrix_ecbSparseInit(  &shardBenchEcb,
+                                EVENT_SHARD_BENCH_ROW,
+                                (pEvFlagMatrix_t)shardBenchObj.evFlagMatrix,
+                                (pEvSparseMatrix_t)shardBenchObj.evSparseMatrix);
+#elif EVENT_MATRIX_AOS_ENABLE
+    eventMatrix_ecbSlotInit(&shardBenchEcb,
+                            EVENT_SHARD_BENCH_ROW,
+                            (pEvFlagMatrix_t)shardBenchObj.evFlagMatrix,
+                            (pEvSlotMatrix_t)shardBenchObj.evSlotMatrix);
+#else
+    eventMatrix_ecbInit(&shardBenchEcb,
+                        EVENT_SHARD_BENCH_ROW,
+                        (pEvFlagMatrix_t)shardBenchObj.evFlagMatrix,
+                        (pEvCbMatrix_t)shardBenchObj.evCbMatrix,
+                        (pEvParaMatrix_t)shardBenchObj.evParaMatrix);
+#endif
+    for (i = 0; i < (int)(EVENT_SHARD_BENCH_ROW * EVENT_MATRIX_COL); i++) {
+        eventMatrix_RegistEvCB(&shardBenchEcb, i, eventBench_handleCb);
+    }
+    if (shard) {
+        eventMatrix_ShardInit(  &shardBenchEcb,
+                                shardBenchShardObj.headArr,
+                                &shardBenchShardObj.flagArr[0][0],
+                                EVENT_SHARD_BENCH_THREAD,
+                                EVENT_SHARD_ROW_SIZE(EVENT_SHARD_BENCH_ROW));
+    }
+
+    benchHits = 0;
+    __atomic_store_n(&shardBenchDoneNum, 0, __ATOMIC_RELAXED);
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (createNum = 0; createNum < threadNum; createNum++) {
+        if (pthread_create(&threadArr[createNum], NULL, eventShardBench_postThread, (void *)(intptr_t)createNum) != 0) {
+            break;
+        }
+    }
+    while (__atomic_load_n(&shardBenchDoneNum, __ATOMIC_ACQUIRE) < createNum) { //主线程作为事件处理线程持续分发
+        eventMatrix_EventProcess(&shardBenchEcb);
+    }
+    for (i = 0; i < createNum; i++) {
+        pthread_join(threadArr[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    eventMatrix_EventProcess(&shardBenchEcb);
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbDynDeinit(&shardBenchEcb);
+#elif EVENT_MATRIX_SPARSE_ENABLE
+    eventMatrix_ecbSparseDeinit(&shardBenchEcb);
+#endif
+
+    if (createNum != threadNum) {
+        return 0;
+    }
+    return (double)threadNum * EVENT_SHARD_BENCH_POST_NUM
+           / ((end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) / 1e9);
+}
+
+/*******************************************************************************
+ *  @brief  分片基准测试设置事件标志线程
+ *  @param  pArg - 线程序号
+ *  @return NULL
+ */
+static void *eventShardBench_postThread(void *pArg) {
+    int id = (int)(intptr_t)pArg;
+    int i;
+
+    eventMatrix_ShardBind(id);                                                  //未初始化分片时直接写事件标志矩阵
+    for (i = 0; i < EVENT_SHARD_BENCH_POST_NUM; i++) {
+        eventMatrix_SetEventFlag(&shardBenchEcb, (i * 7 + id) % (EVENT_SHARD_BENCH_ROW * EVENT_MATRIX_COL));
+    }
+    __atomic_add_fetch(&shardBenchDoneNum, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+#endif
+
+#if EVENT_RECLAIM_ENABLE
+/*******************************************************************************
+ *  @brief  参数回收基准测试函数，每遍事件处理前设置带不同大小参数的事件，
+ *          统计本遍事件处理开始至各回调函数执行的分发延时分位数，
+ *          分别比较回调函数后立即释放、每遍结束时批量释放及后台回收线程释放
+ *  @param  void
+ *  @return void
+ */
+extern void eventReclaimBenchmark(void) {
+    int mode;
+
+    pReclaimBenchLat = malloc(sizeof(uint32_t) * EVENT_RECLAIM_BENCH_EVENT_NUM * EVENT_RECLAIM_BENCH_PASS_NUM);
+    if (pReclaimBenchLat == NULL) {
+        return;
+    }
+    for (mode = 0; mode < 3; mode++) {
+        eventReclaimBenchRun(mode);
+    }
+    free(pReclaimBenchLat);
+    pReclaimBenchLat = NULL;
+}
+
+/*******************************************************************************
+ *  @brief  执行一轮参数回收基准测试并输出结果
+ *  @param  mode - 0 立即释放，1 每遍结束时批量释放，2 后台回收线程释放
+ *  @return void
+ */
+static void eventReclaimBenchRun(int mode) {
+    static const char *pModeName[] = {"inline", "batch", "background"};
+    struct timespec begin, end;
+    uint32_t seed = 12345, num;
+    void *pPara;
+    int i, j;
+
+    if (!eventBenchInit(&benchEcb)) {
+        return;
+    }
+    for (i = 0; i < EVENT_RECLAIM_BENCH_EVENT_NUM; i++) {
+        eventMatrix_RegistEvCB(&benchEcb, i, eventReclaimBench_handleCb);
+    }
+    if (mode == 2 && !eventMatrix_ReclaimerStart(&reclaimBenchReclaimer)) {
+        return;
+    }
+    if (mode != 0) {
+        eventMatrix_ecbReclaimInit(&benchEcb, mode == 2 ? &reclaimBenchReclaimer : NULL);
+    }
+
+    reclaimBenchLatNum = 0;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (i = 0; i < EVENT_RECLAIM_BENCH_PASS_NUM; i++) {
+        for (j = 0; j < EVENT_RECLAIM_BENCH_EVENT_NUM; j++) {                   //线性同余随机参数大小，保证各模式分配序列相同
+            seed  = seed * 1103515245 + 12345;
+            pPara = malloc(16 + (seed >> 8) % EVENT_RECLAIM_BENCH_PARA_MAX);
+            if (pPara != NULL && !eventMatrix_SaveEventPara(&benchEcb, j, pPara)) {
+                free(pPara);
+            }
+            eventMatrix_SetEventFlag(&benchEcb, j);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &reclaimBenchPassBegin);
+        eventMatrix_EventProcess(&benchEcb);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (mode == 2) {
+        eventMatrix_ReclaimerStop(&reclaimBenchReclaimer);
+    }
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    eventMatrix_ecbDynDeinit(&benchEcb);
+#elif EVENT_MATRIX_SPARSE_ENABLE
+    eventMatrix_ecbSparseDeinit(&benchEcb);
+#endif
+
+    num = reclaimBenchLatNum;
+    if (num == 0) {
+        return;
+    }
+    qsort(pReclaimBenchLat, num, sizeof(uint32_t), eventReclaimBench_cmpLat);
+    printf("reclaim: %-10s, dispatch latency p50: %6u ns, p99: %6u ns, p99.9: %6u ns, max: %7u ns, %.1f us/pass\n",
+           pModeName[mode],
+           (unsigned)pReclaimBenchLat[num / 2],
+           (unsigned)pReclaimBenchLat[(uint64_t)num * 99 / 100],
+           (unsigned)pReclaimBenchLat[(uint64_t)num * 999 / 1000],
+           (unsigned)pReclaimBenchLat[num - 1],
+           ((end.tv_sec - begin.tv_sec) * 1e9 + (end.tv_nsec - begin.tv_nsec)) / 1e3 / EVENT_RECLAIM_BENCH_PASS_NUM);
+}
+
+/*******************************************************************************
+ *  @brief  参数回收基准测试事件处理回调函数，记录本遍事件处理开始至执行的分发延时
+ *  @param  pPara - 事件参数
+ *  @return void
+ */
+static void eventReclaimBench_handleCb(void *pPara) {
+    struct timespec now;
+
+    (void)pPara;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (reclaimBenchLatNum < EVENT_RECLAIM_BENCH_EVENT_NUM * EVENT_RECLAIM_BENCH_PASS_NUM) {
+        pReclaimBenchLat[reclaimBenchLatNum++] = (uint32_t)((now.tv_sec - reclaimBenchPassBegin.tv_sec) * 1000000000L
+                                                            + (now.tv_nsec - reclaimBenchPassBegin.tv_nsec));
+    }
+}
+
+/*******************************************************************************
+ *  @brief  分发延时升序比较函数
+ *  @param  pA - 分发延时指针
+ *          pB - 分发延时指针
+ *  @return 比较结果
+ */
+static int eventReclaimBench_cmpLat(const void *pA, const void *pB) {
+    uint32_t a = *(const uint32_t *)pA, b = *(const uint32_t *)pB;
+
+    return (a > b) - (a < b);
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  分发基准测试事件控制块初始化
+ *  @param  pBenchEcb - 事件控制块指针
+ *  @return true      - 初始化成功
+ *          false     - 初始化失败
+ */
+static bool eventBenchInit(pEcb_t pBenchEcb) {
+#if EVENT_MATRIX_DYNAMIC_ENABLE
+    return eventMatrix_ecbDynInit(pBenchEcb, EVENT_BENCH_ROW);
+#elif EVENT_MATRIX_SPARSE_ENABLE
+    return eventMatrix_ecbSparseInit(   pBenchEcb,
+                                        EVENT_BENCH_ROW,
+                                        (pEvFlagMatrix_t)benchObj.evFlagMatrix,
+                                        (pEvSparseMatrix_t)benchObj.evSparseMatrix);
+#elif EVENT_MATRIX_AOS_ENABLE
+    return eventMatrix_ecbSlotInit( pBenchEcb,
+                                    EVENT_BENCH_ROW,
+                                    (pEvFlagMatrix_t)benchObj.evFlagMatrix,
+                                    (pEvSlotMatrix_t)benchObj.evSlotMatrix);
+#else
+    return eventMatrix_ecbInit( pBenchEcb,
+                                EVENT_BENCH_ROW,
+                                (pEvFlagMatrix_t)benchObj.evFlagMatrix,
+                                (pEvCbMatrix_t)benchObj.evCbMatrix,
+                                (pEvParaMatrix_t)benchObj.evParaMatrix);
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  分发基准测试事件处理回调函数
+ *  @param  pPara - 事件参数
+ *  @return void
+ */
+static void eventBench_handleCb(void *pPara) {
+    (void)pPara;
+    benchHits++;
+}
+
 /******************************** END OF FILE **********************************
 *************************** (C) Copyright 2019 REIZ ***************************/
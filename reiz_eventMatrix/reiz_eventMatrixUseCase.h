@@ -18,6 +18,8 @@ extern "C"
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include "reiz_eventMatrix.h"
+
 /* Exported define -----------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
@@ -25,6 +27,13 @@ extern "C"
 
 /* Exported functions prototypes ---------------------------------------------*/
 extern void eventProcessTest(void);
+extern void eventDispatchBenchmark(void);
+#if EVENT_SHARD_ENABLE
+extern void eventShardBenchmark(void);
+#endif
+#if EVENT_RECLAIM_ENABLE
+extern void eventReclaimBenchmark(void);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,329 @@
+/*******************************************************************************
+ *  @file       reiz_strCmdFramer.c
+ *  @author     jxndsfss
+ *  @version    v1.0.0
+ *  @date       2026-10-19
+ *  @site       ShangYouSong.SZ
+ *  @brief      字符串协议命令行分帧源文件，从任意分块的字节流中按"\r\n"切分命令行并送入命令解析
+ *******************************************************************************
+ */
+
+/*******************************************************************************
+ *  @algorithm  增量状态机：crPending 记录上一块数据以'\r'结尾，discard 记录当前行超长丢弃中，
+ *              lineLen 记录行缓冲区中未完成命令行长度；每块数据以 memchr() 查找'\r'，
+ *              完整位于本块中的命令行以原地址送入命令解析，不复制；
+ *              跨越分块边界的命令行才复制到行缓冲区拼接，超过 lineMax 时丢弃至下一个"\r\n"
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "reiz_strCmdFramer.h"
+#include <string.h>
+
+#if CMD_FRAMER_ENABLE
+
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+
+/* 当前使用的行缓冲区块 */
+#if CMD_ZERO_COPY_ENABLE
+#define CMD_FRAMER_LINE_BUF(pFramer)    ((pFramer)->pLineBuf + (pFramer)->bufIdx * (pFramer)->lineMax)
+#else
+#define CMD_FRAMER_LINE_BUF(pFramer)    ((pFramer)->pLineBuf)
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static const char *strCmdFramer_FindLineEnd(pCmdFramer_t pFramer, const char *pData, const char *pEnd);
+static void strCmdFramer_Deliver(pCmdFramer_t pFramer, const char *pLine, int len);
+static void strCmdFramer_Append(pCmdFramer_t pFramer, const char *pData, int len);
+
+/*******************************************************************************
+ *  @brief  命令行分帧器初始化
+ *  @param  pFramer  - 命令行分帧器指针
+ *          pCpcb    - 命令解析控制块指针，须已初始化
+ *          pLineBuf - 行缓冲区，大小为 CMD_FRAMER_LINE_BUF_NUM * lineMax
+ *          lineMax  - 命令行最大长度，含"\r\n"，超长命令行被丢弃
+ *  @return true     - 初始化成功
+ *          false    - 初始化失败
+ */
+extern bool strCmdFramer_Init(  pCmdFramer_t    pFramer,
+                                pCpcb_t         pCpcb,
+                                char            *pLineBuf,
+                                int             lineMax)
+{
+    if (pFramer == NULL || pCpcb == NULL || pLineBuf == NULL || lineMax < 2) {
+        return false;
+    }
+
+    pFramer->pCpcb          =   pCpcb;
+    pFramer->pLineBuf       =   pLineBuf;
+    pFramer->lineMax        =   lineMax;
+    pFramer->lineNum        =   0;
+    pFramer->overlongTimes  =   0;
+#if CMD_ZERO_COPY_ENABLE
+    pFramer->bufIdx         =   0;
+    pFramer->pinNum         =   0;
+#endif
+    strCmdFramer_Reset(pFramer);
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  丢弃未完成的命令行，分帧器回到行首状态，如输入链路重连时调用
+ *  @param  pFramer - 命令行分帧器指针
+ *  @return void
+ */
+extern void strCmdFramer_Reset(pCmdFramer_t pFramer) {
+    if (pFramer == NULL) {
+        return;
+    }
+
+    pFramer->lineLen    = 0;
+    pFramer->crPending  = false;
+    pFramer->discard    = false;
+}
+
+/*******************************************************************************
+ *  @brief  送入一块字节数据，块边界可位于任意位置，包括"\r\n"之间
+ *  @param  pFramer - 命令行分帧器指针
+ *          pData   - 数据起始地址
+ *          len     - 数据长度
+ *  @return 本次送入命令解析的命令行数
+ */
+extern int strCmdFramer_Feed(pCmdFramer_t pFramer, const char *pData, int len) {
+    const char *pEnd, *pLineEnd;
+    uint32_t lineNum;
+
+    if (pFramer == NULL || pData == NULL || len <= 0) {
+        return 0;
+    }
+
+    lineNum = pFramer->lineNum;
+    pEnd    = pData + len;
+
+    while (pData < pEnd) {
+        pLineEnd = strCmdFramer_FindLineEnd(pFramer, pData, pEnd);
+        if (pLineEnd == NULL) {                                                 //剩余数据为未完成命令行
+            strCmdFramer_Append(pFramer, pData, (int)(pEnd - pData));
+            break;
+        }
+
+        if (pFramer->discard) {                                                 //超长命令行结束，恢复接收
+            pFramer->discard = false;
+        } else if (pFramer->lineLen > 0) {                                      //跨越分块边界的命令行，拼接后送入
+            strCmdFramer_Append(pFramer, pData, (int)(pLineEnd - pData));
+            if (!pFramer->discard) {
+                strCmdFramer_Deliver(pFramer, CMD_FRAMER_LINE_BUF(pFramer), pFramer->lineLen);
+#if CMD_ZERO_COPY_ENABLE
+                pFramer->bufIdx ^= 1;                                           //已送入的命令行在命令处理前保持不变
+#endif
+            }
+            pFramer->discard = false;
+        } else if (pLineEnd - pData > pFramer->lineMax) {
+            pFramer->overlongTimes++;
+        } else {                                                                //完整位于本块中的命令行，原地址送入
+            strCmdFramer_Deliver(pFramer, pData, (int)(pLineEnd - pData));
+        }
+        pFramer->lineLen = 0;
+        pData = pLineEnd;
+    }
+
+    return (int)(pFramer->lineNum - lineNum);
+}
+
+/*******************************************************************************
+ *  @brief  读取超长丢弃命令行次数
+ *  @param  pFramer - 命令行分帧器指针
+ *  @return 超长丢弃命令行次数
+ */
+extern uint32_t strCmdFramer_GetOverlongTimes(pCmdFramer_t pFramer) {
+    return pFramer != NULL ? pFramer->overlongTimes : 0;
+}
+
+/*******************************************************************************
+ *  @brief  送入环形队列缓存中的数据，直接读取存储数组，不复制到中间缓冲区；
+ *          零拷贝时每次只处理至存储数组末尾的一段连续数据，该段数据钉住至下次送入或释放时出队
+ *  @param  pFramer - 命令行分帧器指针
+ *          pRingQ  - 环形队列缓存指针
+ *  @return 本次送入命令解析的命令行数
+ */
+#if CMD_FRAMER_RING_QUEUE_ENABLE
+extern int strCmdFramer_FeedRingQueue(pCmdFramer_t pFramer, pRingQueue_t pRingQ) {
+    int32_t start, num;
+    int lineNum = 0;
+
+    if (pFramer == NULL || pRingQ == NULL) {
+        return 0;
+    }
+
+#if CMD_ZERO_COPY_ENABLE
+    strCmdFramer_ReleaseRingQueue(pFramer, pRingQ);
+#endif
+    while (pRingQ->count > 0) {                                                 //数据跨越存储数组末尾时分两段送入
+        start = (pRingQ->head + 1) % pRingQ->size;                              //head为最后取出字节位置
+        num   = pRingQ->size - start < pRingQ->count ? pRingQ->size - start : pRingQ->count;
+
+        lineNum += strCmdFramer_Feed(pFramer, (const char *)pRingQ->pBuffer + start, num);
+#if CMD_ZERO_COPY_ENABLE
+        pFramer->pinNum = num;
+        break;
+#else
+        pRingQ->head   = (start + num - 1) % pRingQ->size;
+        pRingQ->count -= num;
+#endif
+    }
+
+    return lineNum;
+}
+
+/*******************************************************************************
+ *  @brief  出队上次送入时被钉住的数据，命令处理后调用，下次送入时亦自动调用
+ *  @param  pFramer - 命令行分帧器指针
+ *          pRingQ  - 环形队列缓存指针
+ *  @return void
+ */
+#if CMD_ZERO_COPY_ENABLE
+extern void strCmdFramer_ReleaseRingQueue(pCmdFramer_t pFramer, pRingQueue_t pRingQ) {
+    if (pFramer == NULL || pRingQ == NULL) {
+        return;
+    }
+
+    if (pFramer->pinNum > 0 && (int32_t)pFramer->pinNum <= pRingQ->count) {    //队列已被清空时不再出队
+        pRingQ->head   = (pRingQ->head + pFramer->pinNum) % pRingQ->size;
+        pRingQ->count -= pFramer->pinNum;
+    }
+    pFramer->pinNum = 0;
+}
+#endif
+#endif
+
+/*******************************************************************************
+ *  @brief  送入8位元素存储队列中的数据，直接读取存储数组，不复制到中间缓冲区；
+ *          零拷贝时每次只处理至存储数组末尾的一段连续数据，该段数据钉住至下次送入或释放时出队
+ *  @param  pFramer - 命令行分帧器指针
+ *          pQueue  - 8位元素存储队列指针
+ *  @return 本次送入命令解析的命令行数
+ */
+#if CMD_FRAMER_QUEUE_8_ENABLE
+extern int strCmdFramer_FeedQueue8(pCmdFramer_t pFramer, pQueue8_t pQueue) {
+    uint32_t start, num;
+    int lineNum = 0;
+
+    if (pFramer == NULL || pQueue == NULL) {
+        return 0;
+    }
+
+#if CMD_ZERO_COPY_ENABLE
+    strCmdFramer_ReleaseQueue8(pFramer, pQueue);
+#endif
+    while (pQueue->count > 0) {                                                 //数据跨越存储数组末尾时分两段送入
+        start = (pQueue->head + 1) % pQueue->size;                              //head为最后取出元素位置
+        num   = pQueue->size - start < pQueue->count ? pQueue->size - start : pQueue->count;
+
+        lineNum += strCmdFramer_Feed(pFramer, (const char *)pQueue->pBuffer + start, (int)num);
+#if CMD_ZERO_COPY_ENABLE
+        pFramer->pinNum = num;
+        break;
+#else
+        pQueue->head   = (start + num - 1) % pQueue->size;
+        pQueue->count -= num;
+#endif
+    }
+
+    return lineNum;
+}
+
+/*******************************************************************************
+ *  @brief  出队上次送入时被钉住的数据，命令处理后调用，下次送入时亦自动调用
+ *  @param  pFramer - 命令行分帧器指针
+ *          pQueue  - 8位元素存储队列指针
+ *  @return void
+ */
+#if CMD_ZERO_COPY_ENABLE
+extern void strCmdFramer_ReleaseQueue8(pCmdFramer_t pFramer, pQueue8_t pQueue) {
+    if (pFramer == NULL || pQueue == NULL) {
+        return;
+    }
+
+    if (pFramer->pinNum > 0 && pFramer->pinNum <= pQueue->count) {             //队列已被清空时不再出队
+        pQueue->head   = (pQueue->head + pFramer->pinNum) % pQueue->size;
+        pQueue->count -= pFramer->pinNum;
+    }
+    pFramer->pinNum = 0;
+}
+#endif
+#endif
+
+/*******************************************************************************
+ *  @brief  查找命令行结束位置，上一块数据以'\r'结尾时本块首字节'\n'即为行尾，
+ *          更新 crPending 状态
+ *  @param  pFramer - 命令行分帧器指针
+ *          pData   - 数据起始地址
+ *          pEnd    - 数据结束地址
+ *  @return "\r\n"之后的地址，本块中无行尾时返回NULL
+ */
+static const char *strCmdFramer_FindLineEnd(pCmdFramer_t pFramer, const char *pData, const char *pEnd) {
+    const char *pCr;
+
+    if (pFramer->crPending) {
+        pFramer->crPending = false;
+        if (*pData == '\n') {
+            return pData + 1;
+        }
+    }
+
+    for (pCr = pData; (pCr = memchr(pCr, '\r', pEnd - pCr)) != NULL; pCr++) {
+        if (pCr + 1 == pEnd) {                                                  //'\r'位于块尾，等待下一块
+            pFramer->crPending = true;
+            return NULL;
+        }
+        if (pCr[1] == '\n') {
+            return pCr + 2;
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ *  @brief  完整命令行送入命令解析
+ *  @param  pFramer - 命令行分帧器指针
+ *          pLine   - 命令行起始地址
+ *          len     - 命令行长度，含"\r\n"
+ *  @return void
+ */
+static void strCmdFramer_Deliver(pCmdFramer_t pFramer, const char *pLine, int len) {
+    strCmdParse_cmdTypeParseN(pFramer->pCpcb, pLine, len);
+    pFramer->lineNum++;
+}
+
+/*******************************************************************************
+ *  @brief  未完成命令行追加到行缓冲区，超过 lineMax 时计数并丢弃至下一个"\r\n"
+ *  @param  pFramer - 命令行分帧器指针
+ *          pData   - 数据起始地址
+ *          len     - 数据长度
+ *  @return void
+ */
+static void strCmdFramer_Append(pCmdFramer_t pFramer, const char *pData, int len) {
+    if (pFramer->discard) {
+        return;
+    }
+
+    if (len > pFramer->lineMax - pFramer->lineLen) {
+        pFramer->overlongTimes++;
+        pFramer->discard = true;
+        pFramer->lineLen = 0;
+        return;
+    }
+
+    memcpy(CMD_FRAMER_LINE_BUF(pFramer) + pFramer->lineLen, pData, len);
+    pFramer->lineLen += len;
+}
+
+#endif /* CMD_FRAMER_ENABLE */
+
+/******************************** END OF FILE **********************************
+*************************** (C) Copyright 2019 REIZ ***************************/
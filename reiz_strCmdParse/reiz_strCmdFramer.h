@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *  @file       reiz_strCmdFramer.h
+ *  @author     jxndsfss
+ *  @version    v1.0.0
+ *  @date       2026-10-19
+ *  @site       ShangYouSong.SZ
+ *  @brief      字符串协议命令行分帧头文件，从任意分块的字节流中按"\r\n"切分命令行并送入命令解析
+ *******************************************************************************
+ *  使用方法：
+ *  1.reiz_strCmdParse.h 中打开 CMD_FRAMER_ENABLE，按输入来源打开
+ *    CMD_FRAMER_RING_QUEUE_ENABLE / CMD_FRAMER_QUEUE_8_ENABLE
+ *  2.定义分帧对象变量，参数为命令行最大长度（含"\r\n"）
+ *      例：static STR_CMD_FRAMER_OBJ(128) cmdFramerObj;
+ *  3.命令解析控制块初始化后初始化分帧器
+ *      例：strCmdFramer_Init(&cmdFramerObj.framer, pCpcb, cmdFramerObj.lineBuf, 128);
+ *  4.收到数据时送入分帧器，完整命令行直接送入 strCmdParse_cmdTypeParseN()
+ *      例：strCmdFramer_Feed(&cmdFramerObj.framer, pData, len);
+ *      例：strCmdFramer_FeedRingQueue(&cmdFramerObj.framer, pRingQ);
+ *  5.strCmdParse_cmdProcess() 执行命令回调函数
+ *
+ *  零拷贝（CMD_ZERO_COPY_ENABLE 为1）时的附加规则：
+ *  1.完整位于本次输入数据中的命令行直接引用输入数据，输入数据须保持有效至 strCmdParse_cmdProcess() 返回
+ *  2.跨越输入分块边界的命令行拼接于分帧器行缓冲区，行缓冲区为两块交替使用，
+ *    每次送入数据后、下次送入数据前须调用 strCmdParse_cmdProcess()
+ *  3.环形队列输入时每次只处理至存储数组末尾的一段连续数据，该段数据在下次送入时才出队（钉住），
+ *    写入方须先检查 ringQueue_GetFree() / queue8_GetFree() 再写入，以免覆盖被钉住的数据
+ *******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef REIZ_STR_CMD_FRAMER_H
+#define REIZ_STR_CMD_FRAMER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "reiz_strCmdParse.h"
+
+#if CMD_FRAMER_ENABLE
+
+/* Exported define -----------------------------------------------------------*/
+
+/* 宏值：1为打开，0为关闭 */
+#define CMD_FRAMER_RING_QUEUE_ENABLE    0                                       //环形队列缓存(ringQueue_t)输入功能
+#define CMD_FRAMER_QUEUE_8_ENABLE       0                                       //8位元素存储队列(queue8_t)输入功能
+
+/* 行缓冲区块数，零拷贝时两块交替使用，保证上一次送入时拼接的命令行在命令处理前不被覆盖 */
+#if CMD_ZERO_COPY_ENABLE
+#define CMD_FRAMER_LINE_BUF_NUM         2
+#else
+#define CMD_FRAMER_LINE_BUF_NUM         1
+#endif
+
+#if CMD_FRAMER_RING_QUEUE_ENABLE
+#include "reiz_ringQueue.h"
+#endif
+#if CMD_FRAMER_QUEUE_8_ENABLE
+#include "module_Queue_8.h"
+#endif
+
+/* Exported macro ------------------------------------------------------------*/
+
+/*
+    命令行分帧对象宏类型定义
+    使用方法：
+    #define CMD_LINE_MAX  128
+    STR_CMD_FRAMER_OBJ(CMD_LINE_MAX) xxxCmdFramerObj;
+*/
+#define STR_CMD_FRAMER_OBJ(lineMax)                                             \
+struct {                                                                        \
+    cmdFramer_t                         framer;                                 \
+    char                                lineBuf[CMD_FRAMER_LINE_BUF_NUM * (lineMax)];   \
+}
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct cmdFramer_ {                                                     //命令行分帧器类型定义
+    pCpcb_t             pCpcb;                                                  //命令解析控制块指针
+    char                *pLineBuf;                                              //行缓冲区，大小为 CMD_FRAMER_LINE_BUF_NUM * lineMax
+    int                 lineMax;                                                //命令行最大长度，含"\r\n"
+    int                 lineLen;                                                //行缓冲区中未完成命令行的长度
+    bool                crPending;                                              //已收到的最后一个字节为'\r'，等待'\n'
+    bool                discard;                                                //当前命令行超长，丢弃至下一个"\r\n"
+#if CMD_ZERO_COPY_ENABLE
+    int                 bufIdx;                                                 //当前使用的行缓冲区块序号
+    uint32_t            pinNum;                                                 //上次送入后被钉住未出队的队列字节数
+#endif
+    uint32_t            lineNum;                                                //送入命令解析的命令行数
+    uint32_t            overlongTimes;                                          //超长丢弃命令行次数
+} cmdFramer_t, *pCmdFramer_t;
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+extern bool strCmdFramer_Init(  pCmdFramer_t    pFramer,                        //命令行分帧器初始化
+                                pCpcb_t         pCpcb,
+                                char            *pLineBuf,
+                                int             lineMax);
+extern void strCmdFramer_Reset(pCmdFramer_t pFramer);                           //丢弃未完成的命令行
+extern int  strCmdFramer_Feed(pCmdFramer_t pFramer, const char *pData, int len);    //送入一块字节数据，返回送入命令解析的命令行数
+extern uint32_t strCmdFramer_GetOverlongTimes(pCmdFramer_t pFramer);            //读取超长丢弃命令行次数
+
+#if CMD_FRAMER_RING_QUEUE_ENABLE
+extern int  strCmdFramer_FeedRingQueue(pCmdFramer_t pFramer, pRingQueue_t pRingQ);      //送入环形队列缓存中的数据
+#if CMD_ZERO_COPY_ENABLE
+extern void strCmdFramer_ReleaseRingQueue(pCmdFramer_t pFramer, pRingQueue_t pRingQ);   //出队被钉住的数据
+#endif
+#endif
+
+#if CMD_FRAMER_QUEUE_8_ENABLE
+extern int  strCmdFramer_FeedQueue8(pCmdFramer_t pFramer, pQueue8_t pQueue);            //送入8位元素存储队列中的数据
+#if CMD_ZERO_COPY_ENABLE
+extern void strCmdFramer_ReleaseQueue8(pCmdFramer_t pFramer, pQueue8_t pQueue);         //出队被钉住的数据
+#endif
+#endif
+
+#endif /* CMD_FRAMER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REIZ_STR_CMD_FRAMER_H */
+
+/******************************** END OF FILE **********************************
+*************************** (C) Copyright 2019 REIZ ***************************/
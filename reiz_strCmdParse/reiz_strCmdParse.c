@@ -18,19 +18,94 @@
 #include "reiz_strCmdParse.h"
 #include <string.h>
 #include <stdlib.h>
+#if CMD_SCHEMA_ENABLE
+#include <float.h>
+#endif
 
 /* Private define ------------------------------------------------------------*/
 
 #define CMD_TYPE_NULL               0                                           //无效空命令类型
 
+#define CMD_HASH_SEED_MAX           (1 << 20)                                   //构建最小完美散列时每个桶最多尝试的种子数
+
+#define CMD_FLT_OVERFLOW            0x1.ffffffp127                              //FLT_MAX加半个最低位，不小于该值的双精度数舍入为单精度时溢出
+
 /* Private macro -------------------------------------------------------------*/
+
+/* 命令数据包中的空白分隔符 */
+#define CMD_IS_SPACE(c)                 ((c) == ' ' || (c) == '\t' || (c) == '\r' || (c) == '\n')
+
+/* 十进制数字字符转换为数值，非数字字符时大于9 */
+#define CMD_DIGIT(c)                    ((uint32_t)((uint8_t)(c) - '0'))
+
+/* 释放回调函数执行后的命令数据包，使能延迟回收时放入回收列表 */
+#if CMD_RECLAIM_ENABLE
+#define CMD_PARA_FREE(pCpcb, pPara)     strCmdParse_reclaimPut(pCpcb, pPara)
+#else
+#define CMD_PARA_FREE(pCpcb, pPara)     free(pPara)
+#endif
+
+/* 命令参数存储元素传递给回调函数的参数，使能参数向量时为展开后的参数向量指针，零拷贝时为命令切片指针 */
+#if CMD_ARGV_ENABLE
+#define CMD_PARA_ARG(pCpcb, para)       strCmdParse_argvLoad(pCpcb, &(para))
+#elif CMD_ZERO_COPY_ENABLE
+#define CMD_PARA_ARG(pCpcb, para)       ((pPara_t)&(para))
+#else
+#define CMD_PARA_ARG(pCpcb, para)       (para)
+#endif
+
+/* 回调函数执行后释放命令参数存储元素，零拷贝时仅清除切片，输入缓冲区由调用者管理 */
+#if CMD_ZERO_COPY_ENABLE
+#define CMD_PARA_RELEASE(pCpcb, para)   memset(&(para), 0, sizeof(para))
+#else
+#define CMD_PARA_RELEASE(pCpcb, para)   do { if ((para) != NULL) { CMD_PARA_FREE(pCpcb, para); (para) = NULL; } } while (0)
+#endif
+
 /* Private typedef -----------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static int strCmdParse_matchCmdType(const cmdDict_t *pDict, const char *pCmdStr, int len);
+static const char *strCmdParse_strnstr(const char *pStr, int len, const char *pKey);
+static void strCmdParse_cmdDrop(pCpcb_t pCpcb, int row, int col);
+#if CMD_MATCH_AC_ENABLE
+static bool strCmdParse_acBuild(cmdAc_t *pAc, pCmdTypeEleArr_t pCmdTypeEleArr);
+static int strCmdParse_acMatch(const cmdAc_t *pAc, const char *pStr, int len);
+#endif
+#if CMD_MATCH_TOKEN_ENABLE
+static const char *strCmdParse_getToken(const char *pStr, int len, int index, int *pTokenLen);
+static uint32_t strCmdParse_hashStr(uint32_t seed, const char *pStr, int len);
+static bool strCmdParse_hashBuild(cmdHash_t *pHash, pCmdTypeEleArr_t pCmdTypeEleArr);
+static int strCmdParse_hashMatch(const cmdHash_t *pHash, pCmdTypeEleArr_t pCmdTypeEleArr, const char *pToken, int len);
+#endif
+#if CMD_ARGV_ENABLE
+static void strCmdParse_argSplit(const char *pStr, int len, cmdArgIdx_t *pArgIdx);
+static pPara_t strCmdParse_argvLoad(pCpcb_t pCpcb, cmdPara_t *pPara);
+static void strCmdParse_argvFill(cmdArgv_t *pArgv, const char *pLine, const cmdArgIdx_t *pArgIdx);
+#endif
+#if CMD_DIRECT_DISPATCH_ENABLE
+static pCmdCB_t strCmdParse_getDirectCB(pCpcb_t pCpcb, int cmdType);
+#endif
+#if CMD_SCHEMA_ENABLE
+static bool strCmdParse_schemaBuild(pCmdDict_t pDict, pCmdTypeEleArr_t pCmdTypeEleArr);
+static bool strCmdParse_schemaDecode(const cmdSchema_t *pSchema, const char *pStr, int len, cmdArgIdx_t *pArgIdx);
+static int strCmdParse_decodeInt(const char *pStr, const char *pEnd, int32_t *pVal);
+static int strCmdParse_decodeFloat(const char *pStr, const char *pEnd, float *pVal);
+static int strCmdParse_hexDigit(char c);
+#endif
+#if CMD_BATCH_ENABLE
+static void *strCmdParse_batchThread(void *pArg);
+static void strCmdParse_batchWork(cmdBatchJob_t *pJob);
+static bool strCmdParse_batchLine(pCpcb_t pCpcb, const char *pCmdStr, int len, cmdBatchResult_t *pRes);
+static int strCmdParse_batchRun(pCmdBatchPool_t pPool, cmdBatchJob_t *pJob);
+#endif
+#if CMD_RECLAIM_ENABLE
+static void strCmdParse_reclaimPut(pCpcb_t pCpcb, pPara_t pPara);
+static void strCmdParse_reclaimFlush(pCpcb_t pCpcb);
+#endif
 
 /*******************************************************************************
- *  @brief  协议命令解析控制块初始化
+ *  @brief  协议命令解析控制块初始化，命令类型元素数组编译为控制块内置命令字典，见 strCmdParse_dictInit()
  *  @param  pCpcb          - 命令解析控制块指针
  *          matrixRow      - 命令类型矩阵行数
  *          pFlagMatrix    - 命令收到标志矩阵数组指针
@@ -40,6 +115,7 @@
  *  @return true           - 初始化成功
  *          false          - 初始化失败
  */
+#if CMD_DICT_EMBED_ENABLE
 extern bool strCmdParse_cpcbInit(   pCpcb_t             pCpcb,
                                     int                 matrixRow,
                                     pCmdTypeEleArr_t    pCmdTypeEleArr,
@@ -52,17 +128,188 @@ extern bool strCmdParse_cpcbInit(   pCpcb_t             pCpcb,
         return false;
     }
 
+    if (!strCmdParse_dictInit(&pCpcb->dict, pCmdTypeEleArr)) {
+        return false;
+    }
+    if (!strCmdParse_cpcbInitDict(pCpcb, matrixRow, &pCpcb->dict, pFlagMatrix, pCbMatrix, pParaMatrix)) {
+        strCmdParse_dictDeinit(&pCpcb->dict);
+        return false;
+    }
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  协议命令解析控制块初始化，引用已编译的命令字典，不编译查找结构，
+ *          多个控制块可共享同一命令字典，各控制块只保存各自的命令标志、回调函数及参数
+ *          命令字典有参数格式时分配本控制块的参数格式不符计数数组，内存不足时初始化失败
+ *  @param  pCpcb       - 命令解析控制块指针
+ *          matrixRow   - 命令类型矩阵行数
+ *          pDict       - 命令字典指针，须在引用它的全部控制块去初始化后才可去初始化
+ *          pFlagMatrix - 命令收到标志矩阵数组指针
+ *          pCbMatrix   - 命令处理回调函数指针矩阵数组指针
+ *          pParaMatrix - 命令处理回调函数参数指针矩阵数组指针
+ *  @return true        - 初始化成功
+ *          false       - 初始化失败
+ */
+extern bool strCmdParse_cpcbInitDict(   pCpcb_t             pCpcb,
+                                        int                 matrixRow,
+                                        const cmdDict_t     *pDict,
+                                        pFlagMatrix_t       pFlagMatrix,
+                                        pCbMatrix_t         pCbMatrix,
+                                        pParaMatrix_t       pParaMatrix)
+{
+#if CMD_SCHEMA_ENABLE
+    int i;
+
+#endif
+    if (pCpcb == NULL || matrixRow == 0 || pDict == NULL || pDict->pCmdTypeEleArr == NULL ||
+        pFlagMatrix == NULL || pCbMatrix == NULL || pParaMatrix == NULL) {
+        return false;
+    }
+
+#if CMD_SCHEMA_ENABLE
+    pCpcb->pSchemaErrArr = NULL;
+    if (pDict->pSchemaArr != NULL) {                                            //计数随控制块，命令字典初始化后只读
+        for (i = 0; (*pDict->pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++);
+        pCpcb->pSchemaErrArr = (uint32_t *)calloc(i, sizeof(uint32_t));
+        if (pCpcb->pSchemaErrArr == NULL) {
+            return false;
+        }
+    }
+#endif
     pCpcb->matrixRow        =   matrixRow;
-    pCpcb->pCmdTypeEleArr   =   pCmdTypeEleArr;
+    pCpcb->pCmdTypeEleArr   =   pDict->pCmdTypeEleArr;
+    pCpcb->pDict            =   pDict;
     pCpcb->pFlagMatrix      =   pFlagMatrix;
     pCpcb->pCbMatrix        =   pCbMatrix;
     pCpcb->pParaMatrix      =   pParaMatrix;
+#if CMD_DIRECT_DISPATCH_ENABLE
+    pCpcb->pDirectMatrix    =   NULL;
+#endif
+#if CMD_RECLAIM_ENABLE
+    pCpcb->pReclaimCb       =   NULL;
+    pCpcb->reclaimNum       =   0;
+#endif
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  命令字典初始化，将命令类型元素数组编译为只读查找结构，初始化后可由多个控制块、多个线程共享
+ *          使能多模式匹配时将命令类型字符串编译为自动机，
+ *          编译失败（内存不足或命令类型字符串总长超过65535）时逐个命令类型字符串匹配，结果相同
+ *          使能按词匹配时构建命令类型最小完美散列，构建失败时逐个命令类型字符串比较，结果相同
+ *          使能参数格式时编译各命令类型的参数格式字符串，格式字符串有误或内存不足时初始化失败
+ *  @param  pDict          - 命令字典指针
+ *          pCmdTypeEleArr - 命令类型元素数组指针，须在命令字典去初始化前保持有效
+ *  @return true           - 初始化成功
+ *          false          - 初始化失败
+ */
+extern bool strCmdParse_dictInit(pCmdDict_t pDict, pCmdTypeEleArr_t pCmdTypeEleArr) {
+    if (pDict == NULL || pCmdTypeEleArr == NULL) {
+        return false;
+    }
+
+    pDict->pCmdTypeEleArr   =   pCmdTypeEleArr;
+#if CMD_SCHEMA_ENABLE
+    if (!strCmdParse_schemaBuild(pDict, pCmdTypeEleArr)) {                      //参数格式字符串有误时初始化失败
+        return false;
+    }
+#endif
+#if CMD_MATCH_AC_ENABLE
+    strCmdParse_acBuild(&pDict->ac, pCmdTypeEleArr);
+#endif
+#if CMD_MATCH_TOKEN_ENABLE
+    strCmdParse_hashBuild(&pDict->hash, pCmdTypeEleArr);
+#endif
 
     return true;
 }
 
 /*******************************************************************************
- *  @brief  注册协议命令回调函数
+ *  @brief  命令字典去初始化，释放自动机、散列及参数解码器，去初始化后按命令类型元素数组逐个匹配
+ *  @param  pDict - 命令字典指针
+ *  @return void
+ */
+extern void strCmdParse_dictDeinit(pCmdDict_t pDict) {
+    if (pDict == NULL) {
+        return;
+    }
+
+#if CMD_MATCH_AC_ENABLE
+    free(pDict->ac.pTable);
+    pDict->ac.pTable = NULL;
+#endif
+#if CMD_MATCH_TOKEN_ENABLE
+    free(pDict->hash.pDispArr);
+    free(pDict->hash.pSlotArr);
+    pDict->hash.pDispArr = NULL;
+    pDict->hash.pSlotArr = NULL;
+#endif
+#if CMD_SCHEMA_ENABLE
+    free((void *)pDict->pSchemaArr);
+    pDict->pSchemaArr = NULL;
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  协议命令解析控制块去初始化，释放未处理的命令数据包及内置命令字典，零拷贝时丢弃未处理的命令切片，
+ *          引用共享命令字典时不释放命令字典
+ *  @param  pCpcb - 命令解析控制块指针
+ *  @return void
+ */
+extern void strCmdParse_cpcbDeinit(pCpcb_t pCpcb) {
+    int row, col;
+
+    if (pCpcb == NULL || pCpcb->pFlagMatrix == NULL) {
+        return;
+    }
+
+    for (row = 0; row < pCpcb->matrixRow; row++) {
+        for (col = 0; col < (int)MATRIX_COL; col++) {
+            strCmdParse_cmdDrop(pCpcb, row, col);
+        }
+    }
+#if CMD_RECLAIM_ENABLE
+    strCmdParse_reclaimFlush(pCpcb);
+#endif
+#if CMD_SCHEMA_ENABLE
+    free(pCpcb->pSchemaErrArr);
+    pCpcb->pSchemaErrArr = NULL;
+#endif
+#if CMD_DICT_EMBED_ENABLE
+    if (pCpcb->pDict == &pCpcb->dict) {                                         //共享命令字典由其所有者去初始化
+        strCmdParse_dictDeinit(&pCpcb->dict);
+    }
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  丢弃某命令类型未处理的命令，释放命令数据包并删除命令类型标志
+ *  @param  pCpcb - 命令解析控制块指针
+ *          row   - 行
+ *          col   - 列
+ *  @return void
+ */
+static void strCmdParse_cmdDrop(pCpcb_t pCpcb, int row, int col) {
+#if CMD_PARA_QUEUE_ENABLE
+    cmdParaQueue_t *pQueue = &(*pCpcb->pParaMatrix)[row][col];
+    uint32_t i;
+
+    for (i = 0; i < pQueue->count; i++) {
+        CMD_PARA_RELEASE(pCpcb, pQueue->pParaBuf[(pQueue->head + i) % CMD_PARA_QUEUE_DEPTH]);
+    }
+    pQueue->head  = 0;
+    pQueue->count = 0;
+#else
+    CMD_PARA_RELEASE(pCpcb, (*pCpcb->pParaMatrix)[row][col]);
+#endif
+    (*pCpcb->pFlagMatrix)[row] &= ~((FLAG_MATRIX_ROW_TYPE)1 << col);
+}
+
+/*******************************************************************************
+ *  @brief  注册协议命令回调函数，由 strCmdParse_cmdProcess() 执行，已注册为直接调度时改为延迟调度
  *  @param  pCpcb   - 命令解析控制块指针
  *          cmdType - 命令类型
  *          pCmdCb  - 命令解析处理回调函数
@@ -76,26 +323,115 @@ extern bool strCmdParse_registerCmdCB(pCpcb_t pCpcb, int cmdType, pCmdCB_t pCmdC
         row = cmdType / MATRIX_COL;
         col = cmdType % MATRIX_COL;
         (*pCpcb->pCbMatrix)[row][col] = pCmdCb;
+#if CMD_DIRECT_DISPATCH_ENABLE
+        if (pCpcb->pDirectMatrix != NULL) {
+            (*pCpcb->pDirectMatrix)[row] &= ~((FLAG_MATRIX_ROW_TYPE)1 << col);
+        }
+#endif
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  协议命令直接调度矩阵初始化，初始均不直接调度，未初始化时均不直接调度
+ *  @param  pCpcb         - 命令解析控制块指针
+ *          pDirectMatrix - 直接调度矩阵数组指针，行数与命令收到标志矩阵相同
+ *  @return true          - 初始化成功
+ *          false         - 初始化失败
+ */
+#if CMD_DIRECT_DISPATCH_ENABLE
+extern bool strCmdParse_directInit(pCpcb_t pCpcb, pFlagMatrix_t pDirectMatrix) {
+    if (pCpcb == NULL || pDirectMatrix == NULL) {
+        return false;
+    }
+
+    memset(pDirectMatrix, 0, pCpcb->matrixRow * sizeof(FLAG_MATRIX_ROW_TYPE));
+    pCpcb->pDirectMatrix    =   pDirectMatrix;
+
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  注册直接调度的协议命令回调函数，收到该类命令时在解析函数中立即执行，
+ *          参数为借用命令行的 cmdSlice_t 指针（使能参数向量时为 cmdArgv_t 指针），
+ *          已收到未处理的同类命令参数类型不同，注册时丢弃
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          cmdType - 命令类型
+ *          pCmdCb  - 命令解析处理回调函数
+ *  @return true    - 注册成功
+ *          false   - 注册失败，未初始化直接调度矩阵
+ */
+extern bool strCmdParse_registerDirectCmdCB(pCpcb_t pCpcb, int cmdType, pCmdCB_t pCmdCb) {
+    int row, col;
+
+    if (pCpcb != NULL && pCpcb->pDirectMatrix != NULL && cmdType != CMD_TYPE_NULL && pCmdCb != NULL) {
+        row = cmdType / MATRIX_COL;
+        col = cmdType % MATRIX_COL;
+        strCmdParse_cmdDrop(pCpcb, row, col);                                   //延迟调度的命令数据包不可传给直接调度回调函数
+        (*pCpcb->pCbMatrix)[row][col] = pCmdCb;
+        (*pCpcb->pDirectMatrix)[row] |= ((FLAG_MATRIX_ROW_TYPE)1 << col);
         return true;
     }
     return false;
 }
 
 /*******************************************************************************
- *  @brief  设置协议命令类型标志，命令收到时设置，传递命令数据包指针，以供命令解析函数使用
- *  @param  pCpcb    - 命令解析控制块指针
- *          cmdType  - 协议命令类型
- *          pCmdData - 协议命令参数指针
- *  @return true     - 设置成功
- *          false    - 设置失败
+ *  @brief  读取直接调度的命令类型回调函数
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          cmdType - 命令类型
+ *  @return 回调函数指针，NULL为该命令类型延迟调度
+ */
+static pCmdCB_t strCmdParse_getDirectCB(pCpcb_t pCpcb, int cmdType) {
+    int row, col;
+
+    if (pCpcb->pDirectMatrix == NULL || cmdType == CMD_TYPE_NULL) {
+        return NULL;
+    }
+
+    row = cmdType / MATRIX_COL;
+    col = cmdType % MATRIX_COL;
+    if ((*pCpcb->pDirectMatrix)[row] & ((FLAG_MATRIX_ROW_TYPE)1 << col)) {
+        return (*pCpcb->pCbMatrix)[row][col];
+    }
+    return NULL;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  设置协议命令类型标志，命令收到时设置，传递命令数据包，以供命令解析函数使用
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          cmdType - 协议命令类型
+ *          para    - 协议命令参数，命令数据包副本指针或零拷贝时的命令切片
+ *  @return true    - 设置成功，未使能参数队列时覆盖并释放未处理的上一条同类命令
+ *          false   - 设置失败，参数队列已满，参数所有权仍属调用者
  */
-static bool strCmdParse_setCmdFlag(pCpcb_t pCpcb, int cmdType, pPara_t pCmdData) {
+static bool strCmdParse_setCmdFlag(pCpcb_t pCpcb, int cmdType, cmdPara_t para) {
     int row, col;
+#if CMD_PARA_QUEUE_ENABLE
+    cmdParaQueue_t *pQueue;
+#endif
 
     if (pCpcb != NULL && cmdType != CMD_TYPE_NULL) {
         row = cmdType / MATRIX_COL;
         col = cmdType % MATRIX_COL;
-        (*pCpcb->pParaMatrix)[row][col] = pCmdData;                             //存储参数指针
+#if CMD_PARA_QUEUE_ENABLE
+        pQueue = &(*pCpcb->pParaMatrix)[row][col];
+
+        if (pQueue->count >= CMD_PARA_QUEUE_DEPTH) {                            //参数队列已满，丢弃该命令
+#if CMD_PARA_DROP_COUNT_ENABLE
+            pQueue->dropTimes++;
+#endif
+            return false;
+        }
+        pQueue->pParaBuf[(pQueue->head + pQueue->count) % CMD_PARA_QUEUE_DEPTH] = para;  //参数入队尾
+        pQueue->count++;
+#else
+        if ((*pCpcb->pFlagMatrix)[row] & ((FLAG_MATRIX_ROW_TYPE)1 << col)) {    //上一条同类命令未处理，以最新命令为准，释放上一条命令数据包
+            CMD_PARA_RELEASE(pCpcb, (*pCpcb->pParaMatrix)[row][col]);
+        }
+        (*pCpcb->pParaMatrix)[row][col] = para;                                 //存储参数
+#endif
         (*pCpcb->pFlagMatrix)[row] |= ((FLAG_MATRIX_ROW_TYPE)1 << col);         //设置命令类型标志，表示收到该条命令
         return true;
     }
@@ -111,33 +447,263 @@ static bool strCmdParse_setCmdFlag(pCpcb_t pCpcb, int cmdType, pPara_t pCmdData)
  *          false   - 解析失败
  */
 extern bool strCmdParse_cmdTypeParse(pCpcb_t pCpcb, char *pCmdStr) {
-    int i = 0, len;
-    char *pParaStr;
+    if (pCpcb == NULL || pCmdStr == NULL) {
+        return false;
+    }
+    return strCmdParse_cmdTypeParseN(pCpcb, pCmdStr, strlen(pCmdStr));
+}
+
+/*******************************************************************************
+ *  @brief  协议命令类型解析函数，命令数据包按长度给出，无需以'\0'结尾，
+ *          零拷贝时只记录命令切片，不分配内存，输入缓冲区须保持有效至命令处理结束
+ *          直接调度的命令类型在本函数中立即执行回调函数，返回前执行完毕
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          pCmdStr - 命令数据包起始地址
+ *          len     - 命令数据包长度
+ *  @return true    - 解析成功
+ *          false   - 解析失败
+ */
+extern bool strCmdParse_cmdTypeParseN(pCpcb_t pCpcb, const char *pCmdStr, int len) {
+    const cmdDict_t *pDict;
+    int i;
+    cmdPara_t para;
+#if CMD_ARGV_ENABLE
+    cmdArgIdx_t argIdx;
+#endif
+#if CMD_DIRECT_DISPATCH_ENABLE
+    pCmdCB_t pCb;
+#if CMD_ARGV_ENABLE
+    cmdArgv_t argv;                                                             //直接调度的参数向量在栈上展开，回调函数中可嵌套解析
+#else
+    cmdSlice_t slice;
+#endif
+#endif
     bool ret = false;
 
-    if (pCpcb == NULL || pCmdStr == NULL) {
+    if (pCpcb == NULL || pCmdStr == NULL || len < 0) {
+        return ret;
+    }
+
+#if CMD_ARGV_ENABLE
+    if (len > UINT16_MAX) {                                                     //参数下标为16位
         return ret;
     }
+#endif
+    pDict = pCpcb->pDict;
+    i = strCmdParse_matchCmdType(pDict, pCmdStr, len);
+    if (i >= 0) {
+#if CMD_ARGV_ENABLE
+        strCmdParse_argSplit(pCmdStr, len, &argIdx);                            //只切分匹配到命令类型的命令行，回调函数无需再扫描
+#endif
+#if CMD_SCHEMA_ENABLE
+        argIdx.pSchema = NULL;
+        if (pDict->pSchemaArr != NULL && (*pDict->pCmdTypeEleArr)[i].pArgSchema != NULL) {
+            if (!strCmdParse_schemaDecode(&pDict->pSchemaArr[i], pCmdStr, len, &argIdx)) {
+                pCpcb->pSchemaErrArr[i]++;                                      //参数格式不符的命令不调度，计入本控制块
+                return ret;
+            }
+            argIdx.pSchema = &pDict->pSchemaArr[i];
+        }
+#endif
+#if CMD_DIRECT_DISPATCH_ENABLE
+        pCb = strCmdParse_getDirectCB(pCpcb, (*pDict->pCmdTypeEleArr)[i].cmdType);
+        if (pCb != NULL) {                                                      //直接调度的命令类型立即执行回调函数，借用命令行，不复制、不设置命令标志
+#if CMD_ARGV_ENABLE
+            strCmdParse_argvFill(&argv, pCmdStr, &argIdx);
+            pCb(&argv);
+#else
+            slice.pStr = pCmdStr;
+            slice.len  = len;
+            pCb(&slice);
+#endif
+            return true;
+        }
+#endif
+#if CMD_ZERO_COPY_ENABLE
+#if CMD_ARGV_ENABLE
+        para.pStr   = pCmdStr;                                                  //借用输入缓冲区，不复制
+        para.argIdx = argIdx;
+#else
+        para.pStr = pCmdStr;                                                    //借用输入缓冲区，不复制
+        para.len  = len;
+#endif
+
+        //匹配到命令类型，设置命令类型标志，传递命令切片
+        ret = strCmdParse_setCmdFlag(pCpcb, (*pDict->pCmdTypeEleArr)[i].cmdType, para);
+#else
+#if CMD_ARGV_ENABLE
+        para = malloc(sizeof(cmdArgIdx_t) + len + 1);                           //参数下标与命令数据包副本一次分配
+#else
+        para = malloc(len + 1);
+#endif
 
-    while ((*pCpcb->pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL) {
-        if (strstr(pCmdStr, (*pCpcb->pCmdTypeEleArr)[i].pCmdTypeStr)) {
-            len = strlen(pCmdStr);
-            pParaStr = (char *)malloc(len + 1);
+        if (para != NULL) {
+#if CMD_ARGV_ENABLE
+            memcpy(para, &argIdx, sizeof(cmdArgIdx_t));
+            memcpy((cmdArgIdx_t *)para + 1, pCmdStr, len);                      //复制完整命令数据包
+            *((char *)((cmdArgIdx_t *)para + 1) + len) = '\0';
+#else
+            memcpy(para, pCmdStr, len);                                         //复制完整命令数据包
+            *((char *)para + len) = '\0';
+#endif
 
-            if (pParaStr != NULL) {
-                memcpy(pParaStr, pCmdStr, len);                                 //复制完整命令数据包
-                *(pParaStr + len) = '\0';
+            //匹配到命令类型，设置命令类型标志，传递命令包指针
+            ret = strCmdParse_setCmdFlag(pCpcb, (*pDict->pCmdTypeEleArr)[i].cmdType, para);
 
-                //匹配到命令类型，设置命令类型标志，传递命令包指针
-                ret = strCmdParse_setCmdFlag(pCpcb, (*pCpcb->pCmdTypeEleArr)[i].cmdType, pParaStr);
+            if (!ret) {                                                         //命令未能保存则释放命令数据包
+                free(para);
             }
-            return ret;
         }
-        i++;
+#endif
     }
     return ret;
 }
 
+/*******************************************************************************
+ *  @brief  匹配命令数据包中包含的命令类型字符串，多个命令类型字符串均包含时取命令类型元素数组中靠前者
+ *          使能按词匹配时命令类型字符串须与第 CMD_MATCH_TOKEN_INDEX 个词相同
+ *  @param  pDict   - 命令字典指针，只读访问
+ *          pCmdStr - 命令数据包起始地址
+ *          len     - 命令数据包长度
+ *  @return 命令类型元素数组序号，-1为未匹配
+ */
+static int strCmdParse_matchCmdType(const cmdDict_t *pDict, const char *pCmdStr, int len) {
+    int i;
+#if CMD_MATCH_TOKEN_ENABLE
+    const char *pToken;
+    int tokenLen;
+
+    pToken = strCmdParse_getToken(pCmdStr, len, CMD_MATCH_TOKEN_INDEX, &tokenLen);
+    return pToken != NULL ? strCmdParse_hashMatch(&pDict->hash, pDict->pCmdTypeEleArr, pToken, tokenLen) : -1;
+#endif
+#if CMD_MATCH_AC_ENABLE
+    if (pDict->ac.pTable != NULL) {
+        return strCmdParse_acMatch(&pDict->ac, pCmdStr, len);
+    }
+#endif
+    for (i = 0; (*pDict->pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {
+        if (strCmdParse_strnstr(pCmdStr, len, (*pDict->pCmdTypeEleArr)[i].pCmdTypeStr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+ *  @brief  在指定长度的字符串中查找子字符串，遇'\0'提前结束，与 strstr() 结果相同
+ *  @param  pStr - 被查找字符串起始地址
+ *          len  - 被查找字符串最大长度
+ *          pKey - 要查找的子字符串，以'\0'结尾
+ *  @return 子字符串首次出现的地址，未找到返回NULL
+ */
+static const char *strCmdParse_strnstr(const char *pStr, int len, const char *pKey) {
+    int i, keyLen = strlen(pKey);
+
+    if (keyLen == 0) {
+        return pStr;
+    }
+
+    for (i = 0; i + keyLen <= len && pStr[i] != '\0'; i++) {
+        if (pStr[i] == *pKey && memcmp(pStr + i, pKey, keyLen) == 0) {
+            return pStr + i;
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ *  @brief  将命令行按空白切分为参数，记录各参数位置，遇'\0'提前结束，
+ *          参数个数达到 CMD_ARGV_MAX 时剩余部分（去除尾部空白）并入最后一个参数
+ *  @param  pStr    - 命令行起始地址
+ *          len     - 命令行长度，不超过65535
+ *          pArgIdx - 输出命令参数下标
+ *  @return void
+ */
+#if CMD_ARGV_ENABLE
+static void strCmdParse_argSplit(const char *pStr, int len, cmdArgIdx_t *pArgIdx) {
+    int pos = 0, begin, end;
+
+    pArgIdx->lineLen = len;
+    pArgIdx->argc    = 0;
+
+    while (pArgIdx->argc < CMD_ARGV_MAX) {
+        while (pos < len && CMD_IS_SPACE(pStr[pos])) {
+            pos++;
+        }
+        if (pos == len || pStr[pos] == '\0') {
+            break;
+        }
+
+        begin = pos;
+        if (pArgIdx->argc == CMD_ARGV_MAX - 1) {                                //最后一个参数
+            for (end = pos; pos < len && pStr[pos] != '\0'; pos++) {
+                if (!CMD_IS_SPACE(pStr[pos])) {
+                    end = pos + 1;
+                }
+            }
+        } else {
+            for (; pos < len && pStr[pos] != '\0' && !CMD_IS_SPACE(pStr[pos]); pos++);
+            end = pos;
+        }
+        pArgIdx->argOff[pArgIdx->argc].pos = begin;
+        pArgIdx->argOff[pArgIdx->argc].len = end - begin;
+        pArgIdx->argc++;
+    }
+}
+
+/*******************************************************************************
+ *  @brief  由命令参数存储元素中的参数下标展开参数向量到控制块暂存区
+ *  @param  pCpcb - 命令解析控制块指针
+ *          pPara - 命令参数存储元素指针
+ *  @return 参数向量指针，作为回调函数参数
+ */
+static pPara_t strCmdParse_argvLoad(pCpcb_t pCpcb, cmdPara_t *pPara) {
+    const cmdArgIdx_t *pArgIdx;
+    const char *pLine;
+
+#if CMD_ZERO_COPY_ENABLE
+    pArgIdx = &pPara->argIdx;
+    pLine   = pPara->pStr;
+#else
+    pArgIdx = (const cmdArgIdx_t *)*pPara;                                      //参数下标之后为命令数据包副本
+    pLine   = (const char *)(pArgIdx + 1);
+#endif
+
+    strCmdParse_argvFill(&pCpcb->argv, pLine, pArgIdx);
+    return &pCpcb->argv;
+}
+
+/*******************************************************************************
+ *  @brief  按参数下标展开参数向量
+ *  @param  pArgv   - 参数向量指针
+ *          pLine   - 命令行起始地址
+ *          pArgIdx - 参数下标指针
+ *  @return void
+ */
+static void strCmdParse_argvFill(cmdArgv_t *pArgv, const char *pLine, const cmdArgIdx_t *pArgIdx) {
+    int i;
+
+    pArgv->line.pStr = pLine;
+    pArgv->line.len  = pArgIdx->lineLen;
+    pArgv->argc      = pArgIdx->argc;
+    for (i = 0; i < pArgIdx->argc; i++) {
+        pArgv->argv[i].pStr = pLine + pArgIdx->argOff[i].pos;
+        pArgv->argv[i].len  = pArgIdx->argOff[i].len;
+    }
+#if CMD_SCHEMA_ENABLE
+    pArgv->valNum = pArgIdx->pSchema != NULL ? pArgIdx->pSchema->fieldNum : 0;
+    for (i = 0; i < pArgv->valNum; i++) {
+        if (pArgIdx->pSchema->type[i] == 's' || pArgIdx->pSchema->type[i] == 'h') {
+            pArgv->val[i].s.pStr = pLine + pArgIdx->val[i].off.pos;
+            pArgv->val[i].s.len  = pArgIdx->val[i].off.len;
+        } else {
+            pArgv->val[i].i = pArgIdx->val[i].i;                                //整数、枚举及浮点数按位复制
+        }
+    }
+#endif
+}
+#endif
+
 /*******************************************************************************
  *  @brief  命令回调函数执行函数(事件处理函数)
  *  @param  pCpcb - 命令解析控制块指针
@@ -146,7 +712,11 @@ extern bool strCmdParse_cmdTypeParse(pCpcb_t pCpcb, char *pCmdStr) {
 extern void strCmdParse_cmdProcess(pCpcb_t pCpcb) {
     int         row, col, set;
     pCmdCB_t    pCb;
-    pPara_t     pPara;
+    cmdPara_t   para;
+#if CMD_PARA_QUEUE_ENABLE
+    cmdParaQueue_t *pQueue;
+    uint32_t    i, num;
+#endif
 
     if (pCpcb == NULL) {
         return;
@@ -161,19 +731,1084 @@ extern void strCmdParse_cmdProcess(pCpcb_t pCpcb) {
             set = (*pCpcb->pFlagMatrix)[row] & ((FLAG_MATRIX_ROW_TYPE)1 << col);    //获取命令类型标志位
             if (set) {                                                              //命令类型标志位存在
                 pCb = (pCmdCB_t)(*pCpcb->pCbMatrix)[row][col];
-                pPara = (*pCpcb->pParaMatrix)[row][col];
-
-                pCb(pPara);                                                         //执行命令回调函数
+#if CMD_PARA_QUEUE_ENABLE
+                pQueue = &(*pCpcb->pParaMatrix)[row][col];
+                num = pQueue->count;                                                //回调函数中新收到的同类命令下一遍处理
 
-                if (pPara != NULL) {                                                //参数内存未释放则释放参数内存
-                    free(pPara);
-                    (*pCpcb->pParaMatrix)[row][col] = NULL;                         //清零参数指针
+                for (i = 0; i < num; i++) {                                         //按收到顺序依次处理同类命令
+                    para = pQueue->pParaBuf[pQueue->head];                          //先出队再执行回调函数，回调函数中可继续入队
+                    memset(&pQueue->pParaBuf[pQueue->head], 0, sizeof(cmdPara_t));
+                    pQueue->head = (pQueue->head + 1) % CMD_PARA_QUEUE_DEPTH;
+                    pQueue->count--;
+                    pCb(CMD_PARA_ARG(pCpcb, para));
+                    CMD_PARA_RELEASE(pCpcb, para);
                 }
+                if (pQueue->count == 0) {
+                    (*pCpcb->pFlagMatrix)[row] &= ~((FLAG_MATRIX_ROW_TYPE)1 << col);    //删除命令类型标志位
+                }
+#else
+                para = (*pCpcb->pParaMatrix)[row][col];                             //先取出参数并删除标志位，回调函数中可再次收到同类命令
+                memset(&(*pCpcb->pParaMatrix)[row][col], 0, sizeof(cmdPara_t));
                 (*pCpcb->pFlagMatrix)[row] &= ~((FLAG_MATRIX_ROW_TYPE)1 << col);    //删除命令类型标志位
+                pCb(CMD_PARA_ARG(pCpcb, para));                                     //执行命令回调函数
+                CMD_PARA_RELEASE(pCpcb, para);                                      //释放参数内存
+#endif
+            }
+        }
+    }
+#if CMD_RECLAIM_ENABLE
+    strCmdParse_reclaimFlush(pCpcb);                                                //回调函数全部执行后批量释放本遍命令数据包
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  设置命令数据包批量回收回调函数，一遍命令处理结束时以回收列表调用，
+ *          回调函数负责释放数据包，可转交后台线程释放，NULL为在命令处理线程中释放
+ *  @param  pCpcb      - 命令解析控制块指针
+ *          pReclaimCb - 命令数据包批量回收回调函数
+ *  @return true       - 设置成功
+ *          false      - 设置失败
+ */
+#if CMD_RECLAIM_ENABLE
+extern bool strCmdParse_setReclaimCB(pCpcb_t pCpcb, pCmdReclaimCB_t pReclaimCb) {
+    if (pCpcb == NULL) {
+        return false;
+    }
+
+    strCmdParse_reclaimFlush(pCpcb);
+    pCpcb->pReclaimCb = pReclaimCb;
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  命令数据包放入回收列表，列表满时先批量释放
+ *  @param  pCpcb - 命令解析控制块指针
+ *          pPara - 命令数据包指针
+ *  @return void
+ */
+static void strCmdParse_reclaimPut(pCpcb_t pCpcb, pPara_t pPara) {
+    if (pCpcb->reclaimNum >= CMD_RECLAIM_BATCH) {
+        strCmdParse_reclaimFlush(pCpcb);
+    }
+    pCpcb->reclaimArr[pCpcb->reclaimNum++] = pPara;
+}
+
+/*******************************************************************************
+ *  @brief  批量释放回收列表中的命令数据包
+ *  @param  pCpcb - 命令解析控制块指针
+ *  @return void
+ */
+static void strCmdParse_reclaimFlush(pCpcb_t pCpcb) {
+    uint32_t i;
+
+    if (pCpcb->reclaimNum == 0) {
+        return;
+    }
+
+    if (pCpcb->pReclaimCb != NULL) {
+        pCpcb->pReclaimCb(pCpcb->reclaimArr, (int)pCpcb->reclaimNum);
+    } else {
+        for (i = 0; i < pCpcb->reclaimNum; i++) {
+            free(pCpcb->reclaimArr[i]);
+        }
+    }
+    pCpcb->reclaimNum = 0;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  将命令类型字符串编译为Aho-Corasick自动机，字节先映射为字符类以压缩状态表宽度，
+ *          失败转移预先展开为确定状态转移，匹配时每字节一次查表
+ *  @param  pAc            - 命令类型自动机指针
+ *          pCmdTypeEleArr - 命令类型元素数组指针
+ *  @return true           - 编译成功
+ *          false          - 编译失败，状态表为NULL
+ */
+#if CMD_MATCH_AC_ENABLE
+static bool strCmdParse_acBuild(cmdAc_t *pAc, pCmdTypeEleArr_t pCmdTypeEleArr) {
+    const uint8_t *pStr;
+    cmdAcState_t *pTable, *pRow, *pFailRow, *pShrink;
+    int *pFail, *pQueue;
+    int i, c, stride = 2, maxState = 1, stateNum = 1, state, head = 0, tail = 0;
+
+    pAc->pTable = NULL;
+    memset(pAc->classMap, 1, sizeof(pAc->classMap));
+    for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {          //第0列为匹配输出，第1列为其他字节
+        for (pStr = (const uint8_t *)(*pCmdTypeEleArr)[i].pCmdTypeStr; *pStr != '\0'; pStr++, maxState++) {
+            if (pAc->classMap[*pStr] == 1) {
+                if (stride > UINT8_MAX) {
+                    return false;
+                }
+                pAc->classMap[*pStr] = stride++;
+            }
+        }
+    }
+    if (maxState > UINT16_MAX) {
+        return false;
+    }
+
+    pTable = calloc((size_t)maxState * stride, sizeof(cmdAcState_t));
+    pFail  = malloc(maxState * sizeof(int));
+    pQueue = malloc(maxState * sizeof(int));
+    if (pTable == NULL || pFail == NULL || pQueue == NULL) {
+        free(pTable);
+        free(pFail);
+        free(pQueue);
+        return false;
+    }
+
+    for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {          //建立字典树，状态输出记录最靠前的命令类型元素
+        state = 0;
+        for (pStr = (const uint8_t *)(*pCmdTypeEleArr)[i].pCmdTypeStr; *pStr != '\0'; pStr++) {
+            pRow = &pTable[state * stride];
+            if (pRow[pAc->classMap[*pStr]] == 0) {
+                pRow[pAc->classMap[*pStr]] = stateNum++;
             }
+            state = pRow[pAc->classMap[*pStr]];
         }
+        if (pTable[state * stride] == 0) {
+            pTable[state * stride] = i + 1;
+        }
+    }
+
+    for (c = 2; c < stride; c++) {                                              //深度1状态的失败状态为根
+        if (pTable[c] != 0) {
+            pFail[pTable[c]] = 0;
+            pQueue[tail++] = pTable[c];
+        }
+    }
+    while (head < tail) {                                                       //按深度顺序展开，失败状态的行已完成
+        state    = pQueue[head++];
+        pRow     = &pTable[state * stride];
+        pFailRow = &pTable[pFail[state] * stride];
+        if (pFailRow[0] != 0 && (pRow[0] == 0 || pFailRow[0] < pRow[0])) {      //合并失败状态上可匹配的后缀命令类型
+            pRow[0] = pFailRow[0];
+        }
+        for (c = 2; c < stride; c++) {
+            if (pRow[c] != 0) {
+                pFail[pRow[c]] = pFailRow[c];
+                pQueue[tail++] = pRow[c];
+            } else {
+                pRow[c] = pFailRow[c];
+            }
+        }
+    }
+    free(pFail);
+    free(pQueue);
+
+    pShrink = realloc(pTable, (size_t)stateNum * stride * sizeof(cmdAcState_t));
+    pAc->pTable     =   pShrink != NULL ? pShrink : pTable;
+    pAc->stride     =   stride;
+    pAc->stateNum   =   stateNum;
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  以自动机一遍扫描命令数据包，取匹配到的命令类型元素最小序号
+ *  @param  pAc  - 命令类型自动机指针
+ *          pStr - 命令数据包起始地址
+ *          len  - 命令数据包长度，遇'\0'提前结束
+ *  @return 命令类型元素数组序号，-1为未匹配
+ */
+static int strCmdParse_acMatch(const cmdAc_t *pAc, const char *pStr, int len) {
+    const cmdAcState_t *pTable = pAc->pTable;
+    const char *pEnd = pStr + len;
+    uint32_t best = pTable[0] != 0 ? pTable[0] : UINT32_MAX;                   //空命令类型字符串匹配任意命令
+    uint32_t out, state = 0;
+
+    while (pStr < pEnd && *pStr != '\0' && best != 1) {                        //已匹配第一个命令类型元素时提前结束
+        state = pTable[state * pAc->stride + pAc->classMap[(uint8_t)*pStr++]];
+        out   = pTable[state * pAc->stride];
+        if (out != 0 && out < best) {
+            best = out;
+        }
+    }
+    return best != UINT32_MAX ? (int)best - 1 : -1;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  取命令数据包中的第 index 个空白分隔词
+ *  @param  pStr      - 命令数据包起始地址
+ *          len       - 命令数据包长度，遇'\0'提前结束
+ *          index     - 词序号，从0开始
+ *          pTokenLen - 输出词长度
+ *  @return 词首指针，词不存在时返回NULL
+ */
+#if CMD_MATCH_TOKEN_ENABLE
+static const char *strCmdParse_getToken(const char *pStr, int len, int index, int *pTokenLen) {
+    const char *pBegin, *pEnd = pStr + len;
+
+    for (;;) {
+        while (pStr < pEnd && CMD_IS_SPACE(*pStr)) {
+            pStr++;
+        }
+        if (pStr == pEnd || *pStr == '\0') {
+            return NULL;
+        }
+        for (pBegin = pStr; pStr < pEnd && *pStr != '\0' && !CMD_IS_SPACE(*pStr); pStr++);
+        if (index-- == 0) {
+            *pTokenLen = (int)(pStr - pBegin);
+            return pBegin;
+        }
+    }
+}
+
+/*******************************************************************************
+ *  @brief  带种子的FNV散列
+ *  @param  seed - 散列种子，0为默认种子
+ *          pStr - 字符串指针
+ *          len  - 字符串长度
+ *  @return 散列值
+ */
+static uint32_t strCmdParse_hashStr(uint32_t seed, const char *pStr, int len) {
+    uint32_t h = seed != 0 ? seed : 0x01000193u;
+
+    while (len-- > 0) {
+        h = (h * 0x01000193u) ^ (uint8_t)*pStr++;
+    }
+    return h;
+}
+
+/*******************************************************************************
+ *  @brief  构建命令类型最小完美散列（散列与位移法），键数为n时槽位数亦为n，
+ *          按种子0散列分桶，由大到小为每个多键桶寻找使各键落入空槽位的种子，单键桶直接指定空槽位
+ *          重复的命令类型字符串取命令类型元素数组中靠前者，含空白字符或为空的命令类型字符串不参与按词匹配
+ *  @param  pHash          - 命令类型最小完美散列指针
+ *          pCmdTypeEleArr - 命令类型元素数组指针
+ *  @return true           - 构建成功
+ *          false          - 构建失败，位移表为NULL
+ */
+static bool strCmdParse_hashBuild(cmdHash_t *pHash, pCmdTypeEleArr_t pCmdTypeEleArr) {
+    int *pKeyArr, *pBucketArr, *pCountArr, *pUsedArr, *pOrderArr;
+    int32_t *pDispArr;
+    int *pSlotArr;
+    int i, j, k, n = 0, len, bucket, seed, slot, size, freeSlot;
+    const char *pStr;
+    bool ok = false;
+
+    pHash->slotNum  = 0;
+    pHash->pDispArr = NULL;
+    pHash->pSlotArr = NULL;
+    for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++);
+
+    pKeyArr    = malloc((i + 1) * sizeof(int));
+    pBucketArr = malloc((i + 1) * sizeof(int));
+    pCountArr  = calloc(i + 1, sizeof(int));
+    pUsedArr   = calloc(i + 1, sizeof(int));
+    pOrderArr  = malloc((i + 1) * sizeof(int));
+    pDispArr   = calloc(i + 1, sizeof(int32_t));
+    pSlotArr   = malloc((i + 1) * sizeof(int));
+    if (pKeyArr == NULL || pBucketArr == NULL || pCountArr == NULL || pUsedArr == NULL ||
+        pOrderArr == NULL || pDispArr == NULL || pSlotArr == NULL) {
+        goto exit;
+    }
+
+    for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {          //收集有效且不重复的键
+        pStr = (*pCmdTypeEleArr)[i].pCmdTypeStr;
+        for (len = 0; pStr[len] != '\0' && !CMD_IS_SPACE(pStr[len]); len++);
+        if (len == 0 || pStr[len] != '\0') {
+            continue;
+        }
+        for (j = 0; j < n && strcmp((*pCmdTypeEleArr)[pKeyArr[j]].pCmdTypeStr, pStr) != 0; j++);
+        if (j == n) {
+            pKeyArr[n++] = i;
+        }
+    }
+    if (n == 0) {
+        goto exit;
+    }
+
+    for (i = 0; i < n; i++) {
+        pStr = (*pCmdTypeEleArr)[pKeyArr[i]].pCmdTypeStr;
+        pBucketArr[i] = strCmdParse_hashStr(0, pStr, strlen(pStr)) % n;
+        pCountArr[pBucketArr[i]]++;
+    }
+    for (i = 0; i < n; i++) {                                                   //桶按键数由大到小排序，键数相同时按桶号
+        pOrderArr[i] = i;
+    }
+    for (i = 1; i < n; i++) {
+        for (j = i, k = pOrderArr[i]; j > 0 && pCountArr[pOrderArr[j - 1]] < pCountArr[k]; j--) {
+            pOrderArr[j] = pOrderArr[j - 1];
+        }
+        pOrderArr[j] = k;
+    }
+
+    for (i = 0; i < n && pCountArr[pOrderArr[i]] > 1; i++) {                   //多键桶寻找种子
+        bucket = pOrderArr[i];
+        size   = pCountArr[bucket];
+        for (seed = 1; seed < CMD_HASH_SEED_MAX; seed++) {
+            for (j = 0, k = 0; j < n && k < size; j++) {                        //尝试本桶各键，暂以-1标记占用
+                if (pBucketArr[j] != bucket) {
+                    continue;
+                }
+                pStr = (*pCmdTypeEleArr)[pKeyArr[j]].pCmdTypeStr;
+                slot = strCmdParse_hashStr(seed, pStr, strlen(pStr)) % n;
+                if (pUsedArr[slot] != 0) {
+                    break;
+                }
+                pUsedArr[slot] = -1;
+                pSlotArr[slot] = pKeyArr[j];
+                k++;
+            }
+            if (k == size) {
+                break;
+            }
+            for (j = 0; j < n; j++) {                                           //撤销本次尝试
+                if (pUsedArr[j] == -1) {
+                    pUsedArr[j] = 0;
+                }
+            }
+        }
+        if (seed == CMD_HASH_SEED_MAX) {
+            goto exit;
+        }
+        for (j = 0; j < n; j++) {
+            if (pUsedArr[j] == -1) {
+                pUsedArr[j] = 1;
+            }
+        }
+        pDispArr[bucket] = seed;
+    }
+    for (freeSlot = 0; i < n && pCountArr[pOrderArr[i]] == 1; i++) {           //单键桶直接指定空槽位
+        bucket = pOrderArr[i];
+        for (j = 0; pBucketArr[j] != bucket; j++);
+        while (pUsedArr[freeSlot] != 0) {
+            freeSlot++;
+        }
+        pUsedArr[freeSlot] = 1;
+        pSlotArr[freeSlot] = pKeyArr[j];
+        pDispArr[bucket] = -freeSlot - 1;
+    }
+
+    pHash->slotNum  = n;
+    pHash->pDispArr = pDispArr;
+    pHash->pSlotArr = pSlotArr;
+    ok = true;
+exit:
+    if (!ok) {
+        free(pDispArr);
+        free(pSlotArr);
+    }
+    free(pKeyArr);
+    free(pBucketArr);
+    free(pCountArr);
+    free(pUsedArr);
+    free(pOrderArr);
+    return ok;
+}
+
+/*******************************************************************************
+ *  @brief  按词查找命令类型，词经最小完美散列定位唯一候选后比较一次，未构建散列时逐个比较
+ *  @param  pHash          - 命令类型最小完美散列指针
+ *          pCmdTypeEleArr - 命令类型元素数组指针
+ *          pToken         - 命令类型所在词起始地址
+ *          len            - 词长度
+ *  @return 命令类型元素数组序号，-1为未匹配
+ */
+static int strCmdParse_hashMatch(const cmdHash_t *pHash, pCmdTypeEleArr_t pCmdTypeEleArr, const char *pToken, int len) {
+    const char *pKey;
+    int32_t disp;
+    int i;
+
+    if (pHash->pDispArr == NULL) {
+        for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {
+            pKey = (*pCmdTypeEleArr)[i].pCmdTypeStr;
+            if (strncmp(pKey, pToken, len) == 0 && pKey[len] == '\0') {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    disp = pHash->pDispArr[strCmdParse_hashStr(0, pToken, len) % pHash->slotNum];
+    if (disp == 0) {
+        return -1;
+    }
+    i    = pHash->pSlotArr[disp < 0 ? -disp - 1 : (int)(strCmdParse_hashStr(disp, pToken, len) % pHash->slotNum)];
+    pKey = (*pCmdTypeEleArr)[i].pCmdTypeStr;
+    return (strncmp(pKey, pToken, len) == 0 && pKey[len] == '\0') ? i : -1;   //非命令类型的词也会落入某个槽位，须比较确认
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  十六进制字符切片转换为字节数据
+ *  @param  pHex - 十六进制字符切片，参数格式字段'h'的解码值
+ *          pDst - 字节数据存储地址
+ *          size - 存储空间字节数
+ *  @return 转换字节数，-1为存储空间不足或含非十六进制字符
+ */
+#if CMD_SCHEMA_ENABLE
+extern int strCmdParse_hexDecode(const cmdSlice_t *pHex, uint8_t *pDst, int size) {
+    int i, hi, lo;
+
+    if (pHex == NULL || pDst == NULL || pHex->len % 2 != 0 || pHex->len / 2 > size) {
+        return -1;
+    }
+
+    for (i = 0; i < pHex->len / 2; i++) {
+        hi = strCmdParse_hexDigit(pHex->pStr[2 * i]);
+        lo = strCmdParse_hexDigit(pHex->pStr[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            return -1;
+        }
+        pDst[i] = (uint8_t)((hi << 4) | lo);
+    }
+    return i;
+}
+
+/*******************************************************************************
+ *  @brief  读取本控制块参数格式不符拒绝命令次数，含批量解析拒绝的命令行
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          cmdType - 命令类型
+ *  @return 拒绝次数
+ */
+extern uint32_t strCmdParse_getSchemaErrTimes(pCpcb_t pCpcb, int cmdType) {
+    const cmdDict_t *pDict;
+    int i;
+
+    if (pCpcb == NULL || pCpcb->pDict == NULL || pCpcb->pSchemaErrArr == NULL || cmdType == CMD_TYPE_NULL) {
+        return 0;
+    }
+
+    pDict = pCpcb->pDict;
+    for (i = 0; (*pDict->pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {
+        if ((*pDict->pCmdTypeEleArr)[i].cmdType == cmdType) {
+            return pCpcb->pSchemaErrArr[i];
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ *  @brief  将各命令类型元素的参数格式字符串编译为参数解码器，均无参数格式时不分配解码器数组
+ *  @param  pDict          - 命令字典指针
+ *          pCmdTypeEleArr - 命令类型元素数组指针
+ *  @return true           - 编译成功
+ *          false          - 参数格式字符串有误或内存不足
+ */
+static bool strCmdParse_schemaBuild(pCmdDict_t pDict, pCmdTypeEleArr_t pCmdTypeEleArr) {
+    cmdSchema_t *pSchemaArr, *pSchema;
+    const char *p;
+    int i, n = 0, nameLen;
+
+    pDict->pSchemaArr = NULL;
+    for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {
+        n += (*pCmdTypeEleArr)[i].pArgSchema != NULL;
+    }
+    if (n == 0) {
+        return true;
+    }
+
+    pSchemaArr = (cmdSchema_t *)calloc(i, sizeof(cmdSchema_t));
+    if (pSchemaArr == NULL) {
+        return false;
+    }
+
+    for (i = 0; (*pCmdTypeEleArr)[i].cmdType != CMD_TYPE_NULL; i++) {
+        pSchema = &pSchemaArr[i];
+        for (p = (*pCmdTypeEleArr)[i].pArgSchema; p != NULL && *p != '\0'; ) {
+            if (*p == ' ') {
+                p++;
+                continue;
+            }
+            if (pSchema->fieldNum >= CMD_SCHEMA_FIELD_MAX) {
+                goto exit;
+            }
+
+            switch (*p) {
+            case 'i':
+            case 'f':
+            case 's':
+            case 'h':
+                pSchema->type[pSchema->fieldNum++] = *p++;
+                break;
+            case 'e':                                                           //e(A|B|C)，名称非空且不含空白
+                if (p[1] != '(') {
+                    goto exit;
+                }
+                pSchema->pEnum[pSchema->fieldNum] = p + 2;
+                pSchema->type[pSchema->fieldNum++] = 'e';
+                for (p += 2, nameLen = 0; *p != ')'; p++) {
+                    if (*p == '\0' || CMD_IS_SPACE(*p) || (*p == '|' && nameLen == 0)) {
+                        goto exit;
+                    }
+                    nameLen = *p == '|' ? 0 : nameLen + 1;
+                }
+                if (nameLen == 0) {
+                    goto exit;
+                }
+                p++;
+                break;
+            default:
+                goto exit;
+            }
+        }
+    }
+    pDict->pSchemaArr = pSchemaArr;                                             //编译完成后只读
+    return true;
+
+exit:
+    free(pSchemaArr);
+    return false;
+}
+
+/*******************************************************************************
+ *  @brief  按参数解码器一遍解码第 CMD_MATCH_TOKEN_INDEX+1 个词起的参数，遇'\0'视为行尾，
+ *          字段缺失、格式不符、数值溢出或有多余参数时解码失败
+ *  @param  pSchema - 参数解码器指针
+ *          pStr    - 命令行起始地址
+ *          len     - 命令行长度
+ *          pArgIdx - 命令参数下标，已切分，解码值写入其中
+ *  @return true    - 解码成功
+ *          false   - 参数格式不符
+ */
+static bool strCmdParse_schemaDecode(const cmdSchema_t *pSchema, const char *pStr, int len, cmdArgIdx_t *pArgIdx) {
+    const char *p, *q, *pName, *pEnd = pStr + len;
+    int f, n, k, idx;
+
+    p = pArgIdx->argc > CMD_MATCH_TOKEN_INDEX + 1 ? pStr + pArgIdx->argOff[CMD_MATCH_TOKEN_INDEX + 1].pos : pEnd;
+
+    for (f = 0; f < pSchema->fieldNum; f++) {
+        while (p < pEnd && CMD_IS_SPACE(*p)) {
+            p++;
+        }
+        if (p == pEnd || *p == '\0') {                                          //字段缺失
+            return false;
+        }
+
+        switch (pSchema->type[f]) {
+        case 'i':
+            n = strCmdParse_decodeInt(p, pEnd, &pArgIdx->val[f].i);
+            break;
+        case 'f':
+            n = strCmdParse_decodeFloat(p, pEnd, &pArgIdx->val[f].f);
+            break;
+        case 'e':                                                               //逐个比较枚举名称
+            for (n = 0; p + n < pEnd && p[n] != '\0' && !CMD_IS_SPACE(p[n]); n++);
+            for (pName = pSchema->pEnum[f], idx = 0; ; pName += k + 1, idx++) {
+                for (k = 0; pName[k] != '|' && pName[k] != ')'; k++);
+                if (k == n && memcmp(pName, p, n) == 0) {
+                    break;
+                }
+                if (pName[k] == ')') {
+                    n = 0;
+                    break;
+                }
+            }
+            pArgIdx->val[f].i = idx;
+            break;
+        case 's':                                                               //值为引号内切片
+            q = *p == '"' ? memchr(p + 1, '"', pEnd - p - 1) : NULL;
+            n = 0;
+            if (q != NULL) {
+                pArgIdx->val[f].off.pos = p + 1 - pStr;
+                pArgIdx->val[f].off.len = q - p - 1;
+                n = q - p + 1;
+            }
+            break;
+        default:                                                                //'h'，偶数个十六进制字符
+            for (n = 0; p + n < pEnd && strCmdParse_hexDigit(p[n]) >= 0; n++);
+            pArgIdx->val[f].off.pos = p - pStr;
+            pArgIdx->val[f].off.len = n;
+            if (n % 2 != 0) {
+                n = 0;
+            }
+            break;
+        }
+
+        if (n == 0) {
+            return false;
+        }
+        p += n;
+        if (p < pEnd && *p != '\0' && !CMD_IS_SPACE(*p)) {                      //字段后须为空白或行尾
+            return false;
+        }
+    }
+
+    while (p < pEnd && CMD_IS_SPACE(*p)) {
+        p++;
+    }
+    return p == pEnd || *p == '\0';                                             //不允许多余参数
+}
+
+/*******************************************************************************
+ *  @brief  解码十进制32位有符号整数，可带正负号，溢出时解码失败
+ *  @param  pStr - 数字起始地址
+ *          pEnd - 命令行结束地址
+ *          pVal - 输出整数值
+ *  @return 解码字符数，0为解码失败
+ */
+static int strCmdParse_decodeInt(const char *pStr, const char *pEnd, int32_t *pVal) {
+    const char *p = pStr;
+    uint32_t v = 0, d, limit;
+    bool neg = false;
+
+    if (p < pEnd && (*p == '+' || *p == '-')) {
+        neg = *p++ == '-';
+    }
+    if (p == pEnd || CMD_DIGIT(*p) > 9) {
+        return 0;
+    }
+
+    limit = neg ? (uint32_t)INT32_MAX + 1 : (uint32_t)INT32_MAX;
+    for (; p < pEnd && (d = CMD_DIGIT(*p)) <= 9; p++) {
+        if (v > (limit - d) / 10) {
+            return 0;
+        }
+        v = v * 10 + d;
+    }
+
+    *pVal = !neg ? (int32_t)v : (v == 0 ? 0 : -(int32_t)(v - 1) - 1);
+    return (int)(p - pStr);
+}
+
+/*******************************************************************************
+ *  @brief  解码浮点数，格式为 [+-]digits[.digits][(e|E)[+-]digits]，整数部分与小数部分至少一个非空，
+ *          有效数字累加为64位整数尾数后按10的幂一次缩放，超出float范围时解码失败
+ *  @param  pStr - 数字起始地址
+ *          pEnd - 命令行结束地址
+ *          pVal - 输出浮点数值
+ *  @return 解码字符数，0为解码失败
+ */
+static int strCmdParse_decodeFloat(const char *pStr, const char *pEnd, float *pVal) {
+    static const double pow10Arr[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *p = pStr;
+    uint64_t mant = 0;
+    uint32_t d;
+    int scale = 0, digits = 0, exp = 0;
+    bool neg = false, expNeg = false;
+    double v;
+
+    if (p < pEnd && (*p == '+' || *p == '-')) {
+        neg = *p++ == '-';
+    }
+    for (; p < pEnd && (d = CMD_DIGIT(*p)) <= 9; p++, digits++) {               //尾数最多保留18位有效数字
+        if (mant < 100000000000000000ull) {
+            mant = mant * 10 + d;
+        } else {
+            scale++;
+        }
+    }
+    if (p < pEnd && *p == '.') {
+        for (p++; p < pEnd && (d = CMD_DIGIT(*p)) <= 9; p++, digits++) {
+            if (mant < 100000000000000000ull) {
+                mant = mant * 10 + d;
+                scale--;
+            }
+        }
+    }
+    if (digits == 0) {
+        return 0;
+    }
+
+    if (p < pEnd && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < pEnd && (*p == '+' || *p == '-')) {
+            expNeg = *p++ == '-';
+        }
+        if (p == pEnd || CMD_DIGIT(*p) > 9) {
+            return 0;
+        }
+        for (; p < pEnd && (d = CMD_DIGIT(*p)) <= 9; p++) {
+            if (exp < 10000) {
+                exp = exp * 10 + d;
+            }
+        }
+    }
+    scale += expNeg ? -exp : exp;
+
+    v = (double)mant;
+    if (v != 0) {
+        for (; scale > 22 && v <= FLT_MAX; scale -= 22) {
+            v *= 1e22;
+        }
+        for (; scale < -22 && v != 0; scale += 22) {
+            v /= 1e22;
+        }
+        if (scale > 22) {
+            return 0;
+        }
+        v = scale >= 0 ? v * pow10Arr[scale] : (scale >= -22 ? v / pow10Arr[-scale] : 0);
+    }
+    if (v >= CMD_FLT_OVERFLOW) {                                                //舍入后仍可表示的值不拒绝
+        return 0;
+    }
+
+    *pVal = (float)(neg ? -v : v);
+    return (int)(p - pStr);
+}
+
+/*******************************************************************************
+ *  @brief  十六进制字符转换为数值
+ *  @param  c - 字符
+ *  @return 0~15，-1为非十六进制字符
+ */
+static int strCmdParse_hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  创建批量解析线程池
+ *  @param  pPool     - 线程池指针
+ *          threadNum - 工作线程数（不含调用线程），不可大于 CMD_BATCH_THREAD_MAX
+ *  @return true      - 创建成功
+ *          false     - 创建失败
+ */
+#if CMD_BATCH_ENABLE
+extern bool strCmdParse_batchStart(pCmdBatchPool_t pPool, int threadNum) {
+    int i;
+
+    if (pPool == NULL || threadNum < 0 || threadNum > CMD_BATCH_THREAD_MAX) {
+        return false;
+    }
+
+    memset(pPool, 0, sizeof(cmdBatchPool_t));
+    pPool->run = true;
+    if (pthread_mutex_init(&pPool->lock, NULL) != 0) {
+        return false;
+    }
+    if (pthread_cond_init(&pPool->startCond, NULL) != 0) {
+        pthread_mutex_destroy(&pPool->lock);
+        return false;
+    }
+    if (pthread_cond_init(&pPool->doneCond, NULL) != 0) {
+        pthread_cond_destroy(&pPool->startCond);
+        pthread_mutex_destroy(&pPool->lock);
+        return false;
+    }
+    for (i = 0; i < threadNum; i++) {
+        if (pthread_create(&pPool->threadArr[i], NULL, strCmdParse_batchThread, pPool) != 0) {
+            break;
+        }
+        pPool->threadNum++;
+    }
+    if (pPool->threadNum < threadNum) {                                         //部分线程创建失败，停止已创建的线程
+        strCmdParse_batchStop(pPool);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ *  @brief  停止批量解析线程池，等待工作线程退出
+ *  @param  pPool - 线程池指针
+ *  @return void
+ */
+extern void strCmdParse_batchStop(pCmdBatchPool_t pPool) {
+    int i;
+
+    if (pPool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pPool->lock);
+    pPool->run = false;
+    pthread_cond_broadcast(&pPool->startCond);
+    pthread_mutex_unlock(&pPool->lock);
+    for (i = 0; i < pPool->threadNum; i++) {
+        pthread_join(pPool->threadArr[i], NULL);
+    }
+    pPool->threadNum = 0;
+    pthread_cond_destroy(&pPool->doneCond);
+    pthread_cond_destroy(&pPool->startCond);
+    pthread_mutex_destroy(&pPool->lock);
+}
+
+/*******************************************************************************
+ *  @brief  批量解析命令行切片数组，结果按输入顺序写入结果数组，不设置命令标志、不执行回调函数
+ *  @param  pPool    - 线程池指针，NULL为在调用线程中逐行解析
+ *          pCpcb    - 命令解析控制块指针
+ *          pLineArr - 命令行切片数组
+ *          lineNum  - 命令行数
+ *          pResArr  - 结果数组，元素数不小于 lineNum
+ *  @return 匹配到命令类型的命令行数，-1为参数错误
+ */
+extern int strCmdParse_batchParse(  pCmdBatchPool_t     pPool,
+                                    pCpcb_t             pCpcb,
+                                    const cmdSlice_t    *pLineArr,
+                                    int                 lineNum,
+                                    cmdBatchResult_t    *pResArr)
+{
+    cmdBatchJob_t job;
+
+    if (pCpcb == NULL || pLineArr == NULL || lineNum < 0 || pResArr == NULL) {
+        return -1;
+    }
+
+    job.pCpcb       =   pCpcb;
+    job.pLineArr    =   pLineArr;
+    job.pBuf        =   NULL;
+    job.pOffArr     =   NULL;
+    job.pResArr     =   pResArr;
+    job.lineNum     =   lineNum;
+    return strCmdParse_batchRun(pPool, &job);
+}
+
+/*******************************************************************************
+ *  @brief  批量解析缓冲区中按偏移给出的命令行，结果按输入顺序写入结果数组，不设置命令标志、不执行回调函数
+ *  @param  pPool   - 线程池指针，NULL为在调用线程中逐行解析
+ *          pCpcb   - 命令解析控制块指针
+ *          pBuf    - 命令行缓冲区
+ *          pOffArr - 命令行起始偏移数组，元素数为 lineNum+1，第i行为 [pOffArr[i], pOffArr[i+1])
+ *          lineNum - 命令行数
+ *          pResArr - 结果数组，元素数不小于 lineNum
+ *  @return 匹配到命令类型的命令行数，-1为参数错误
+ */
+extern int strCmdParse_batchParseBuf(   pCmdBatchPool_t     pPool,
+                                        pCpcb_t             pCpcb,
+                                        const char          *pBuf,
+                                        const uint32_t      *pOffArr,
+                                        int                 lineNum,
+                                        cmdBatchResult_t    *pResArr)
+{
+    cmdBatchJob_t job;
+
+    if (pCpcb == NULL || pBuf == NULL || pOffArr == NULL || lineNum < 0 || pResArr == NULL) {
+        return -1;
+    }
+
+    job.pCpcb       =   pCpcb;
+    job.pLineArr    =   NULL;
+    job.pBuf        =   pBuf;
+    job.pOffArr     =   pOffArr;
+    job.pResArr     =   pResArr;
+    job.lineNum     =   lineNum;
+    return strCmdParse_batchRun(pPool, &job);
+}
+
+/*******************************************************************************
+ *  @brief  展开批量解析结果的参数向量
+ *  @param  pLine - 该结果对应的命令行起始地址
+ *          pRes  - 批量解析结果指针
+ *          pArgv - 参数向量指针
+ *  @return true  - 展开成功
+ *          false - 该命令行未匹配到命令类型
+ */
+#if CMD_ARGV_ENABLE
+extern bool strCmdParse_batchArgv(const char *pLine, const cmdBatchResult_t *pRes, cmdArgv_t *pArgv) {
+    if (pLine == NULL || pRes == NULL || pArgv == NULL || pRes->cmdType == CMD_TYPE_NULL) {
+        return false;
+    }
+
+    strCmdParse_argvFill(pArgv, pLine, &pRes->argIdx);
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  执行一批命令行解析，调用线程与工作线程共同领取命令行，全部完成后返回
+ *  @param  pPool - 线程池指针，NULL为在调用线程中逐行解析
+ *          pJob  - 本批次参数
+ *  @return 匹配到命令类型的命令行数
+ */
+static int strCmdParse_batchRun(pCmdBatchPool_t pPool, cmdBatchJob_t *pJob) {
+    int matchNum;
+#if CMD_SCHEMA_ENABLE
+    int i, errNum;
+#endif
+
+    if (pPool == NULL || pPool->threadNum == 0) {
+        pJob->nextLine = 0;
+        pJob->matchNum = 0;
+#if CMD_SCHEMA_ENABLE
+        pJob->errNum   = 0;
+#endif
+        strCmdParse_batchWork(pJob);
+        matchNum = pJob->matchNum;
+#if CMD_SCHEMA_ENABLE
+        errNum   = pJob->errNum;
+#endif
+        goto exit;
+    }
+
+    pthread_mutex_lock(&pPool->lock);
+    pPool->job          =   *pJob;
+    pPool->job.nextLine =   0;
+    pPool->job.matchNum =   0;
+#if CMD_SCHEMA_ENABLE
+    pPool->job.errNum   =   0;
+#endif
+    pPool->busyNum      =   pPool->threadNum;
+    pPool->seq++;
+    pthread_cond_broadcast(&pPool->startCond);
+    pthread_mutex_unlock(&pPool->lock);
+
+    strCmdParse_batchWork(&pPool->job);                                         //调用线程同时领取命令行
+
+    pthread_mutex_lock(&pPool->lock);
+    while (pPool->busyNum > 0) {
+        pthread_cond_wait(&pPool->doneCond, &pPool->lock);
+    }
+    matchNum = pPool->job.matchNum;
+#if CMD_SCHEMA_ENABLE
+    errNum   = pPool->job.errNum;
+#endif
+    pthread_mutex_unlock(&pPool->lock);
+
+exit:
+#if CMD_SCHEMA_ENABLE
+    for (i = 0; errNum > 0 && i < pJob->lineNum; i++) {                         //工作线程不写控制块，由调用线程计入参数格式不符次数，无拒绝时不扫描
+        if (pJob->pResArr[i].cmdType == CMD_TYPE_NULL && pJob->pResArr[i].eleIdx >= 0) {
+            pJob->pCpcb->pSchemaErrArr[pJob->pResArr[i].eleIdx]++;
+            errNum--;
+        }
+    }
+#endif
+    return matchNum;
+}
+
+/*******************************************************************************
+ *  @brief  批量解析工作线程，等待新批次并领取命令行
+ *  @param  pArg - 线程池指针
+ *  @return NULL
+ */
+static void *strCmdParse_batchThread(void *pArg) {
+    pCmdBatchPool_t pPool = (pCmdBatchPool_t)pArg;
+    uint32_t seq = 0;                                                           //线程池创建时批次序号为0，线程启动前已开始的批次亦须参与
+
+    pthread_mutex_lock(&pPool->lock);
+    for (;;) {
+        while (pPool->run && pPool->seq == seq) {
+            pthread_cond_wait(&pPool->startCond, &pPool->lock);
+        }
+        if (!pPool->run) {
+            break;
+        }
+        seq = pPool->seq;
+        pthread_mutex_unlock(&pPool->lock);
+
+        strCmdParse_batchWork(&pPool->job);
+
+        pthread_mutex_lock(&pPool->lock);
+        if (--pPool->busyNum == 0) {
+            pthread_cond_signal(&pPool->doneCond);
+        }
+    }
+    pthread_mutex_unlock(&pPool->lock);
+    return NULL;
+}
+
+/*******************************************************************************
+ *  @brief  按 CMD_BATCH_CHUNK 行分块领取并解析命令行，直到本批次命令行领取完毕
+ *  @param  pJob - 本批次指针
+ *  @return void
+ */
+static void strCmdParse_batchWork(cmdBatchJob_t *pJob) {
+    int i, end, matchNum = 0;
+#if CMD_SCHEMA_ENABLE
+    int errNum = 0;
+#endif
+    const char *pStr;
+    int len;
+
+    for (;;) {
+        i = __atomic_fetch_add(&pJob->nextLine, CMD_BATCH_CHUNK, __ATOMIC_RELAXED);
+        if (i >= pJob->lineNum) {
+            break;
+        }
+        end = pJob->lineNum - i > CMD_BATCH_CHUNK ? i + CMD_BATCH_CHUNK : pJob->lineNum;
+        for (; i < end; i++) {
+            if (pJob->pLineArr != NULL) {
+                pStr = pJob->pLineArr[i].pStr;
+                len  = pJob->pLineArr[i].len;
+            } else {
+                pStr = pJob->pBuf + pJob->pOffArr[i];
+                len  = (int)(pJob->pOffArr[i + 1] - pJob->pOffArr[i]);
+            }
+            if (strCmdParse_batchLine(pJob->pCpcb, pStr, len, &pJob->pResArr[i])) {
+                matchNum++;
+            }
+#if CMD_SCHEMA_ENABLE
+            else if (pJob->pResArr[i].eleIdx >= 0) {                            //匹配到命令类型但参数格式不符
+                errNum++;
+            }
+#endif
+        }
+    }
+    __atomic_fetch_add(&pJob->matchNum, matchNum, __ATOMIC_RELAXED);
+#if CMD_SCHEMA_ENABLE
+    __atomic_fetch_add(&pJob->errNum, errNum, __ATOMIC_RELAXED);
+#endif
+}
+
+/*******************************************************************************
+ *  @brief  批量解析单行命令，只读访问命令解析控制块，与 strCmdParse_cmdTypeParseN() 匹配结果相同
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          pCmdStr - 命令行起始地址
+ *          len     - 命令行长度
+ *          pRes    - 结果指针
+ *  @return true    - 匹配到命令类型
+ *          false   - 未匹配或参数格式不符
+ */
+static bool strCmdParse_batchLine(pCpcb_t pCpcb, const char *pCmdStr, int len, cmdBatchResult_t *pRes) {
+    const cmdDict_t *pDict = pCpcb->pDict;
+    int i;
+
+    pRes->cmdType = CMD_TYPE_NULL;
+    pRes->eleIdx  = -1;
+    if (pCmdStr == NULL || len < 0) {
+        return false;
+    }
+#if CMD_ARGV_ENABLE
+    if (len > UINT16_MAX) {                                                     //参数下标为16位
+        return false;
+    }
+#endif
+
+    i = strCmdParse_matchCmdType(pDict, pCmdStr, len);
+    if (i < 0) {
+        return false;
+    }
+    pRes->eleIdx = i;
+#if CMD_ARGV_ENABLE
+    strCmdParse_argSplit(pCmdStr, len, &pRes->argIdx);
+#endif
+#if CMD_SCHEMA_ENABLE
+    pRes->argIdx.pSchema = NULL;
+    if (pDict->pSchemaArr != NULL && (*pDict->pCmdTypeEleArr)[i].pArgSchema != NULL) {
+        if (!strCmdParse_schemaDecode(&pDict->pSchemaArr[i], pCmdStr, len, &pRes->argIdx)) {
+            return false;                                                       //参数格式不符时保留命令类型元素序号，批次结束后计数
+        }
+        pRes->argIdx.pSchema = &pDict->pSchemaArr[i];
+    }
+#endif
+    pRes->cmdType = (*pDict->pCmdTypeEleArr)[i].cmdType;
+    return true;
+}
+#endif
+
+/*******************************************************************************
+ *  @brief  读取命令参数队列丢弃命令次数
+ *  @param  pCpcb   - 命令解析控制块指针
+ *          cmdType - 命令类型
+ *  @return 丢弃次数
+ */
+#if CMD_PARA_QUEUE_ENABLE && CMD_PARA_DROP_COUNT_ENABLE
+extern uint32_t strCmdParse_getParaDropTimes(pCpcb_t pCpcb, int cmdType) {
+    int row, col;
+
+    if (pCpcb != NULL && cmdType != CMD_TYPE_NULL) {
+        row = cmdType / MATRIX_COL;
+        col = cmdType % MATRIX_COL;
+        return (*pCpcb->pParaMatrix)[row][col].dropTimes;
     }
+    return 0;
 }
+#endif
 
 /******************************** END OF FILE **********************************
 *************************** (C) Copyright 2019 REIZ ***************************/
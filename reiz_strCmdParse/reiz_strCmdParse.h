@@ -41,18 +41,133 @@ extern "C"
 */
 #define MATRIX_COL              (sizeof( FLAG_MATRIX_ROW_TYPE ) * 8)
 
+/* 宏值：1为打开，0为关闭 */
+#define CMD_PARA_QUEUE_ENABLE           0                                       //命令参数队列功能，命令处理前多次收到的同类命令按顺序依次处理，关闭时未处理的同类命令被后到者覆盖并释放
+#define CMD_PARA_DROP_COUNT_ENABLE      1                                       //参数队列满时丢弃命令次数统计功能
+#define CMD_RECLAIM_ENABLE              0                                       //命令数据包延迟回收功能，回调函数执行后数据包暂存于回收列表，一遍命令处理结束时批量释放
+#define CMD_MATCH_AC_ENABLE             0                                       //命令类型多模式匹配功能，初始化时将命令类型字符串编译为Aho-Corasick自动机，每行命令一遍扫描匹配全部命令类型
+#define CMD_MATCH_TOKEN_ENABLE          0                                       //命令类型按词匹配功能，取命令数据包中第 CMD_MATCH_TOKEN_INDEX 个空白分隔词，经初始化时构建的最小完美散列查找命令类型
+#define CMD_ZERO_COPY_ENABLE            0                                       //命令数据包零拷贝功能，不复制命令数据包，回调函数参数为指向输入缓冲区的命令切片指针
+#define CMD_ARGV_ENABLE                 0                                       //命令参数向量功能，解析时将命令行按空白切分为参数切片，回调函数参数为 cmdArgv_t 参数向量指针
+#define CMD_SCHEMA_ENABLE               0                                       //命令参数格式功能，命令类型元素可带参数格式字符串，初始化时编译为解码器，解析时解码参数，格式不符的命令不调度
+#define CMD_DIRECT_DISPATCH_ENABLE      0                                       //命令直接调度功能，按命令类型注册为直接调度的回调函数在解析函数中立即执行，借用命令行，不复制、不经命令标志矩阵
+#define CMD_BATCH_ENABLE                0                                       //命令行批量解析功能(POSIX线程)，线程池各线程并行只读匹配命令类型，结果按输入顺序写入结果数组
+#define CMD_DICT_EMBED_ENABLE           1                                       //控制块内置命令字典功能，strCmdParse_cpcbInit() 将命令类型元素数组编译于控制块内，全部控制块均引用共享命令字典时可关闭以减小控制块
+#define CMD_FRAMER_ENABLE               0                                       //命令行分帧功能，从任意分块的字节流中按"\r\n"切分命令行送入命令解析，见 reiz_strCmdFramer.h
+
+/*
+    每个命令类型参数队列深度，即命令处理前每个命令类型最多可缓存的命令数据包个数
+*/
+#define CMD_PARA_QUEUE_DEPTH            4
+
+/*
+    命令数据包回收列表容量，一遍命令处理中回收列表满时立即批量释放
+*/
+#define CMD_RECLAIM_BATCH               32
+
+/*
+    按词匹配时命令类型所在词序号，从0开始，例："CMD SetDeviceName ..." 中命令类型为第1个词
+*/
+#define CMD_MATCH_TOKEN_INDEX           1
+
+/*
+    每行命令最多切分的参数个数，超出时剩余部分（去除首尾空白）并入最后一个参数
+    例：CMD_ARGV_MAX 为3时，"CMD SetDeviceName OnePlus 3T\r\n" 切分为 "CMD" "SetDeviceName" "OnePlus 3T"
+*/
+#define CMD_ARGV_MAX                    8
+
+/*
+    参数格式最多字段数，参数格式字符串由以下字段组成，字段间可有空格，参数从第 CMD_MATCH_TOKEN_INDEX+1 个词开始：
+    i           - 十进制32位有符号整数
+    f           - 浮点数，例：-1.5、3e-2
+    e(A|B|C)    - 枚举，值为名称序号，例：e(ON|OFF) 中 "OFF" 为1
+    s           - 双引号字符串，不支持转义，值为引号内切片
+    h           - 十六进制数据，偶数个十六进制字符，值为十六进制字符切片，以 strCmdParse_hexDecode() 转换
+    例：{ CMD_TYPE_SET_ALARM, "SetAlarm", "i f e(ON|OFF) s" } 接受 "CMD SetAlarm 3 36.5 ON \"kitchen\"\r\n"
+*/
+#define CMD_SCHEMA_FIELD_MAX            4
+
+/*
+    批量解析线程池最大工作线程数（不含调用线程），及各线程每次领取的命令行数
+*/
+#define CMD_BATCH_THREAD_MAX            8
+#define CMD_BATCH_CHUNK                 256
+
+#if CMD_MATCH_AC_ENABLE && CMD_MATCH_TOKEN_ENABLE
+#error "CMD_MATCH_AC_ENABLE and CMD_MATCH_TOKEN_ENABLE are mutually exclusive, choose substring or token matching"
+#endif
+
+#if CMD_SCHEMA_ENABLE && (!CMD_ARGV_ENABLE || CMD_ARGV_MAX <= CMD_MATCH_TOKEN_INDEX + 1)
+#error "CMD_SCHEMA_ENABLE requires CMD_ARGV_ENABLE with CMD_ARGV_MAX greater than CMD_MATCH_TOKEN_INDEX + 1, decoded values are delivered in cmdArgv_t"
+#endif
+
+#if CMD_ZERO_COPY_ENABLE && CMD_RECLAIM_ENABLE
+#error "CMD_RECLAIM_ENABLE has nothing to reclaim when CMD_ZERO_COPY_ENABLE is set, command payloads are borrowed"
+#endif
+
+/*
+    零拷贝命令数据包所有权及生命周期规则（CMD_ZERO_COPY_ENABLE 为1时）：
+    1.解析函数只记录命令数据包在输入缓冲区中的起始地址及长度，不分配内存、不复制数据
+    2.调用者须保证该段输入缓冲区在分发该命令的 strCmdParse_cmdProcess() 返回前有效且不被修改，
+      例：行缓冲区在命令处理后才复用；环形队列在命令处理后才出队释放该段数据（钉住该段区域）
+    3.回调函数参数为 cmdSlice_t 指针（使能参数向量时为 cmdArgv_t 指针），切片不保证以'\0'结尾，须按长度访问且不可写入
+    4.切片及其指向的数据仅在回调函数执行期间有效，回调函数返回后不可再引用，需要保存时自行复制
+    5.strCmdParse_cpcbDeinit() 丢弃未处理的切片，不访问输入缓冲区
+*/
+
+/*
+    直接调度命令规则（CMD_DIRECT_DISPATCH_ENABLE 为1时）：
+    1.strCmdParse_directInit() 设置直接调度矩阵后，以 strCmdParse_registerDirectCmdCB() 注册的命令类型
+      在 strCmdParse_cmdTypeParse() / strCmdParse_cmdTypeParseN() 中立即执行回调函数，返回前执行完毕
+    2.回调函数参数为借用输入命令行的 cmdSlice_t 指针（使能参数向量时为 cmdArgv_t 指针），与是否使能零拷贝无关，
+      切片不保证以'\0'结尾，仅在回调函数执行期间有效
+    3.回调函数在解析函数调用者的上下文中执行，须在主循环中执行的命令类型仍以 strCmdParse_registerCmdCB() 注册，
+      由 strCmdParse_cmdProcess() 执行
+    4.回调函数中可再次调用解析函数，参数向量在解析函数栈上展开，嵌套调度互不影响
+*/
+
+/*
+    共享命令字典规则：
+    1.strCmdParse_dictInit() 将命令类型元素数组编译为命令字典（自动机、散列及参数解码器），只编译一次
+    2.各连接以 strCmdParse_cpcbInitDict() 初始化各自的控制块并引用该命令字典，控制块只保存各自的命令标志、回调函数、参数
+      及参数格式不符次数，不编译查找结构；关闭 CMD_DICT_EMBED_ENABLE 可去除控制块中的内置命令字典
+    3.命令字典初始化后只读，可由多个控制块在多个线程中同时解析，参数格式不符次数累计于各控制块
+    4.命令字典及其命令类型元素数组须在引用它的全部控制块去初始化后才可去初始化或释放
+*/
+
+/*
+    命令行批量解析规则（CMD_BATCH_ENABLE 为1时）：
+    1.strCmdParse_batchStart() 创建线程池，批量解析时调用线程与工作线程按 CMD_BATCH_CHUNK 行分块领取命令行，
+      各线程只读共享控制块引用的命令字典（命令类型元素数组、自动机、散列及参数解码器），结果写入输入序号对应的结果元素
+    2.批量解析只匹配命令类型（使能参数向量及参数格式时同时切分、解码参数），不设置命令标志、不执行回调函数，
+      调用者按输入顺序遍历结果数组处理
+    3.批量解析期间不可初始化、去初始化该命令解析控制块，同一线程池不可并发批量解析
+    4.结果中的参数下标相对于各命令行起始地址，命令行数据须保持有效至结果处理完毕
+    5.pPool 为NULL时在调用线程中逐行解析，结果相同
+    6.参数格式不符的命令行结果命令类型为0、命令类型元素序号不为-1，批量解析返回前由调用线程计入该控制块的
+      strCmdParse_getSchemaErrTimes()，工作线程不写控制块
+*/
+
 /* Exported macro ------------------------------------------------------------*/
 
+#if CMD_DIRECT_DISPATCH_ENABLE
+#define CMD_DIRECT_OBJ_MEMBER(row)      FLAG_MATRIX_ROW_TYPE directMatrix[row];
+#else
+#define CMD_DIRECT_OBJ_MEMBER(row)
+#endif
+
 /*
     协议解析对象宏类型定义
     使用方法：
     #define MATRIX_ROW  2
     STR_CMD_PARSE_OJB(MATRIX_ROW) xxxCmdParseOjb;
+    使能直接调度时以 strCmdParse_directInit(pCpcb, (pFlagMatrix_t)xxxCmdParseOjb.directMatrix) 设置直接调度矩阵
 */
 #define STR_CMD_PARSE_OJB(row)  struct {                                        \
                                     FLAG_MATRIX_ROW_TYPE    flagMatrix[row];    \
                                     cbMatrixRowArray_t      cbMatrix[row];      \
                                     paraMatrixRowArray_t    paraMatrix[row];    \
+                                    CMD_DIRECT_OBJ_MEMBER(row)                  \
                                 }
 
 /* Exported types ------------------------------------------------------------*/
@@ -60,44 +175,264 @@ extern "C"
 typedef void (*pCmdCB_t)(void *pPara);                                          //协议命令处理回调函数指针类型定义
 typedef void *pPara_t;                                                          //协议命令处理函数参数指针类型定义
 
+typedef struct cmdSlice_ {                                                      //命令切片数据类型定义，指向调用者缓冲区中的一段数据，不以'\0'结尾
+    const char              *pStr;                                              //切片起始地址
+    int                     len;                                                //切片长度
+} cmdSlice_t;
+
+#if CMD_ARGV_ENABLE
+typedef struct cmdArgOff_ {                                                     //命令参数位置数据类型定义
+    uint16_t                pos;                                                //参数相对命令行起始的偏移
+    uint16_t                len;                                                //参数长度
+} cmdArgOff_t;
+
+#if CMD_SCHEMA_ENABLE
+typedef union cmdArgVal_ {                                                      //命令参数解码值数据类型定义，传递给回调函数
+    int32_t                 i;                                                  //整数及枚举序号
+    float                   f;                                                  //浮点数
+    cmdSlice_t              s;                                                  //引号内字符串及十六进制字符切片
+} cmdArgVal_t;
+
+typedef union cmdArgRaw_ {                                                      //命令参数解码值存储类型定义，随命令数据包保存，切片以相对命令行的位置保存
+    int32_t                 i;
+    float                   f;
+    cmdArgOff_t             off;
+} cmdArgRaw_t;
+
+typedef struct cmdSchema_ {                                                     //命令参数格式解码器数据类型定义，初始化时由参数格式字符串编译
+    uint8_t                 fieldNum;                                           //字段数
+    uint8_t                 type[CMD_SCHEMA_FIELD_MAX];                         //字段类型，'i' 'f' 'e' 's' 'h'
+    const char              *pEnum[CMD_SCHEMA_FIELD_MAX];                       //枚举字段名称列表起始地址，名称以'|'分隔，以')'结束
+} cmdSchema_t;
+#endif
+
+typedef struct cmdArgIdx_ {                                                     //命令参数下标数据类型定义，解析时记录，随命令数据包保存
+    uint16_t                lineLen;                                            //命令行长度，使能参数向量时命令行长度不超过65535
+    uint16_t                argc;                                               //参数个数
+    cmdArgOff_t             argOff[CMD_ARGV_MAX];                               //各参数位置
+#if CMD_SCHEMA_ENABLE
+    const cmdSchema_t       *pSchema;                                           //参数解码器，NULL为命令类型无参数格式
+    cmdArgRaw_t             val[CMD_SCHEMA_FIELD_MAX];                          //按参数格式解码的参数值
+#endif
+} cmdArgIdx_t;
+
+typedef struct cmdArgv_ {                                                       //命令参数向量数据类型定义，命令处理时由参数下标展开，传递给回调函数
+    cmdSlice_t              line;                                               //完整命令行
+    int                     argc;                                               //参数个数
+    cmdSlice_t              argv[CMD_ARGV_MAX];                                 //各参数切片，不以'\0'结尾
+#if CMD_SCHEMA_ENABLE
+    int                     valNum;                                             //解码参数值个数，命令类型无参数格式时为0
+    cmdArgVal_t             val[CMD_SCHEMA_FIELD_MAX];                          //解码参数值，按参数格式字段顺序
+#endif
+} cmdArgv_t;
+#endif
+
+#if CMD_ZERO_COPY_ENABLE && CMD_ARGV_ENABLE
+typedef struct cmdPara_ {                                                       //协议命令参数存储元素类型定义，零拷贝时为命令行起始地址及参数下标
+    const char              *pStr;                                              //命令行起始地址
+    cmdArgIdx_t             argIdx;                                             //命令参数下标
+} cmdPara_t;
+#elif CMD_ZERO_COPY_ENABLE
+typedef cmdSlice_t cmdPara_t;                                                   //协议命令参数存储元素类型定义，零拷贝时为命令切片
+#else
+typedef pPara_t cmdPara_t;                                                      //协议命令参数存储元素类型定义，为命令数据包副本指针，使能参数向量时副本前为参数下标
+#endif
+#if CMD_RECLAIM_ENABLE
+typedef void (*pCmdReclaimCB_t)(pPara_t *pParaArr, int num);                    //命令数据包批量回收回调函数指针类型定义，可转交后台线程释放
+#endif
+
 typedef struct cmdTypeElement_ {                                                //协议命令类型元素数据类型定义
     int     cmdType;                                                            //协议命令类型
     char    *pCmdTypeStr;                                                       //协议命令类型字符串指针
+#if CMD_SCHEMA_ENABLE
+    char    *pArgSchema;                                                        //参数格式字符串指针，NULL为不解码参数
+#endif
 } cmdTypeElement_t;
 
 typedef cmdTypeElement_t (*pCmdTypeEleArr_t)[];                                 //协议命令类型字符串指针数组指针类型定义（一维数组指针）
 typedef FLAG_MATRIX_ROW_TYPE (*pFlagMatrix_t)[];                                //协议命令收到标志矩阵数组指针类型定义（一维数组指针）
 typedef pCmdCB_t cbMatrixRowArray_t[MATRIX_COL];                                //协议命令回调函数指针矩阵行元素数组类型定义（大小为sizeof(FLAG_MATRIX_ROW_TYPE)*8的函数指针数组）
 typedef cbMatrixRowArray_t (*pCbMatrix_t)[];                                    //协议命令回调函数指针矩阵数组指针类型定义（二维数组指针）
-typedef pPara_t paraMatrixRowArray_t[MATRIX_COL];                               //协议命令参数指针矩阵行元素数组类型定义（大小为sizeof(FLAG_MATRIX_ROW_TYPE)*8的指针数组）
+#if CMD_PARA_QUEUE_ENABLE
+typedef struct cmdParaQueue_ {                                                  //协议命令参数队列数据类型定义，存储空间随协议解析对象静态分配
+    cmdPara_t               pParaBuf[CMD_PARA_QUEUE_DEPTH];                     //命令数据包环形存储数组，自队首起按收到顺序排列
+    uint32_t                head;                                               //队首命令数据包存储位置
+    uint32_t                count;                                              //队列当前存储命令数据包个数
+#if CMD_PARA_DROP_COUNT_ENABLE
+    uint32_t                dropTimes;                                          //队列满时丢弃命令次数
+#endif
+} cmdParaQueue_t;
+typedef cmdParaQueue_t paraMatrixRowArray_t[MATRIX_COL];                        //协议命令参数队列矩阵行元素数组类型定义（大小为sizeof(FLAG_MATRIX_ROW_TYPE)*8的队列数组）
+#else
+typedef cmdPara_t paraMatrixRowArray_t[MATRIX_COL];                             //协议命令参数矩阵行元素数组类型定义（大小为sizeof(FLAG_MATRIX_ROW_TYPE)*8的参数存储元素数组）
+#endif
 typedef paraMatrixRowArray_t (*pParaMatrix_t)[];                                //协议命令参数指针矩阵数组指针类型定义（二维数组指针）
 
+#if CMD_MATCH_AC_ENABLE
+typedef uint16_t cmdAcState_t;                                                  //自动机状态类型，状态数最多为65535
+
+typedef struct cmdAc_ {                                                         //命令类型Aho-Corasick自动机数据类型定义
+    uint8_t                 classMap[256];                                      //字节所属字符类，1为不出现于任何命令类型字符串的字节
+    int                     stride;                                             //状态表每行元素数，即字符类数+1
+    int                     stateNum;                                           //状态数
+    cmdAcState_t            *pTable;                                            //状态表，每行第0个元素为该状态匹配到的命令类型元素最小序号+1（0为无），其后为各字符类的转移状态
+} cmdAc_t;
+#endif
+
+#if CMD_MATCH_TOKEN_ENABLE
+typedef struct cmdHash_ {                                                       //命令类型最小完美散列数据类型定义
+    int                     slotNum;                                            //槽位数，即不重复的命令类型字符串数
+    int32_t                 *pDispArr;                                          //位移表，按种子0散列取下标，>0为重新散列的种子，<0为槽位-1取负，0为空
+    int                     *pSlotArr;                                          //各槽位的命令类型元素数组序号
+} cmdHash_t;
+#endif
+
+typedef struct cmdDict_ {                                                       //命令字典数据类型定义，命令类型元素数组编译后的查找结构，初始化后只读，可由多个控制块、多个线程共享
+    pCmdTypeEleArr_t        pCmdTypeEleArr;                                     //协议命令类型字符串指针数组指针
+#if CMD_MATCH_AC_ENABLE
+    cmdAc_t                 ac;                                                 //命令类型自动机，未编译成功时状态表为NULL，逐个命令类型字符串匹配
+#endif
+#if CMD_MATCH_TOKEN_ENABLE
+    cmdHash_t               hash;                                               //命令类型最小完美散列，未构建成功时位移表为NULL，逐个命令类型字符串比较
+#endif
+#if CMD_SCHEMA_ENABLE
+    const cmdSchema_t       *pSchemaArr;                                        //各命令类型元素的参数解码器数组，NULL为均无参数格式
+#endif
+} cmdDict_t, *pCmdDict_t;
+
 typedef struct cmdParseControlBlock_ {                                          //协议命令解析控制块数据类型定义
     int                     matrixRow;                                          //协议命令类型矩阵行数
-    pCmdTypeEleArr_t        pCmdTypeEleArr;                                     //协议命令类型字符串指针数组指针
+    pCmdTypeEleArr_t        pCmdTypeEleArr;                                     //协议命令类型字符串指针数组指针，与命令字典中的相同
+    const cmdDict_t         *pDict;                                             //命令字典指针，指向内置命令字典或共享命令字典
     pFlagMatrix_t           pFlagMatrix;                                        //协议命令标志矩阵数组指针
     pCbMatrix_t             pCbMatrix;                                          //协议命令处理回调函数指针矩阵指针
     pParaMatrix_t           pParaMatrix;                                        //协议命令参数集合数据结构指针矩阵
+#if CMD_DIRECT_DISPATCH_ENABLE
+    pFlagMatrix_t           pDirectMatrix;                                      //协议命令直接调度矩阵，第n位为1表示第n列命令类型在解析函数中直接执行回调函数，NULL为均不直接调度
+#endif
+#if CMD_DICT_EMBED_ENABLE
+    cmdDict_t               dict;                                               //内置命令字典，strCmdParse_cpcbInit() 编译
+#endif
+#if CMD_ARGV_ENABLE
+    cmdArgv_t               argv;                                               //命令参数向量暂存区，每次执行回调函数前展开，回调函数返回后不可再引用
+#endif
+#if CMD_SCHEMA_ENABLE
+    uint32_t                *pSchemaErrArr;                                     //各命令类型元素参数格式不符拒绝命令次数，命令字典有参数格式时初始化分配，否则为NULL
+#endif
+#if CMD_RECLAIM_ENABLE
+    pCmdReclaimCB_t         pReclaimCb;                                         //命令数据包批量回收回调函数，NULL为在命令处理线程中释放
+    uint32_t                reclaimNum;                                         //回收列表中命令数据包个数
+    pPara_t                 reclaimArr[CMD_RECLAIM_BATCH];                      //命令数据包回收列表
+#endif
 } cpcb_t, *pCpcb_t;
 
+#if CMD_BATCH_ENABLE
+#include <pthread.h>
+
+typedef struct cmdBatchResult_ {                                                //命令行批量解析结果数据类型定义，与输入命令行一一对应
+    int                     cmdType;                                            //协议命令类型，0为未匹配或参数格式不符
+    int                     eleIdx;                                             //命令类型元素数组序号，-1为未匹配
+#if CMD_ARGV_ENABLE
+    cmdArgIdx_t             argIdx;                                             //参数下标，以 strCmdParse_batchArgv() 展开为参数向量
+#endif
+} cmdBatchResult_t;
+
+typedef struct cmdBatchJob_ {                                                   //命令行批量解析批次数据类型定义
+    pCpcb_t                 pCpcb;                                              //命令解析控制块，批量解析期间只读
+    const cmdSlice_t        *pLineArr;                                          //命令行切片数组，NULL时按 pBuf/pOffArr 取命令行
+    const char              *pBuf;                                              //命令行缓冲区
+    const uint32_t          *pOffArr;                                           //各命令行起始偏移，第i行为 [pOffArr[i], pOffArr[i+1])
+    cmdBatchResult_t        *pResArr;                                           //结果数组
+    int                     lineNum;                                            //命令行数
+    int                     nextLine;                                           //下一个待领取的命令行序号
+    int                     matchNum;                                           //匹配到命令类型的命令行数
+#if CMD_SCHEMA_ENABLE
+    int                     errNum;                                             //参数格式不符的命令行数，批次结束后计入控制块
+#endif
+} cmdBatchJob_t;
+
+typedef struct cmdBatchPool_ {                                                  //命令行批量解析线程池数据类型定义
+    pthread_mutex_t         lock;
+    pthread_cond_t          startCond;                                          //新批次开始或线程池停止
+    pthread_cond_t          doneCond;                                           //工作线程完成本批次
+    pthread_t               threadArr[CMD_BATCH_THREAD_MAX];
+    int                     threadNum;                                          //工作线程数
+    bool                    run;
+    uint32_t                seq;                                                //批次序号，工作线程据此识别新批次
+    int                     busyNum;                                            //本批次尚未完成的工作线程数
+    cmdBatchJob_t           job;                                                //本批次
+} cmdBatchPool_t, *pCmdBatchPool_t;
+#endif
+
 /* Exported variables --------------------------------------------------------*/
 
 /* Exported functions prototypes ---------------------------------------------*/
 
+#if CMD_DICT_EMBED_ENABLE
 extern bool strCmdParse_cpcbInit(   pCpcb_t             pCpcb,                  //协议命令解析控制块初始化
                                     int                 matrixRow,
                                     pCmdTypeEleArr_t    pCmdTypeEleArr,
                                     pFlagMatrix_t       pFlagMatrix,
                                     pCbMatrix_t         pCbMatrix,
                                     pParaMatrix_t       pParaMatrix);
+#endif
+extern bool strCmdParse_cpcbInitDict(   pCpcb_t             pCpcb,              //协议命令解析控制块初始化，引用共享命令字典
+                                        int                 matrixRow,
+                                        const cmdDict_t     *pDict,
+                                        pFlagMatrix_t       pFlagMatrix,
+                                        pCbMatrix_t         pCbMatrix,
+                                        pParaMatrix_t       pParaMatrix);
+extern bool strCmdParse_dictInit(pCmdDict_t pDict, pCmdTypeEleArr_t pCmdTypeEleArr);   //命令字典初始化，编译命令类型元素数组
+extern void strCmdParse_dictDeinit(pCmdDict_t pDict);                           //命令字典去初始化，须在引用它的全部控制块去初始化后调用
+extern void strCmdParse_cpcbDeinit(pCpcb_t pCpcb);                              //协议命令解析控制块去初始化，释放未处理命令数据包及匹配数据结构
 
 extern bool strCmdParse_registerCmdCB(  pCpcb_t pCpcb,                          //注册协议命令回调函数
                                         int cmdType, 
                                         pCmdCB_t pCmdCb); 
 
+#if CMD_DIRECT_DISPATCH_ENABLE
+extern bool strCmdParse_directInit(pCpcb_t pCpcb, pFlagMatrix_t pDirectMatrix);    //协议命令直接调度矩阵初始化，初始均不直接调度
+extern bool strCmdParse_registerDirectCmdCB(pCpcb_t pCpcb,                      //注册直接调度的协议命令回调函数，在解析函数中立即执行
+                                            int cmdType,
+                                            pCmdCB_t pCmdCb);
+#endif
+
 extern bool strCmdParse_cmdTypeParse(pCpcb_t pCpcb, char *pCmdStr);             //协议命令类型解析函数
+extern bool strCmdParse_cmdTypeParseN(pCpcb_t pCpcb, const char *pCmdStr, int len);    //协议命令类型解析函数，命令数据包按长度给出
 extern void strCmdParse_cmdProcess(pCpcb_t pCpcb);                              //命令回调函数执行函数
 
+#if CMD_RECLAIM_ENABLE
+extern bool strCmdParse_setReclaimCB(pCpcb_t pCpcb, pCmdReclaimCB_t pReclaimCb);   //设置命令数据包批量回收回调函数
+#endif
+
+#if CMD_SCHEMA_ENABLE
+extern int strCmdParse_hexDecode(const cmdSlice_t *pHex, uint8_t *pDst, int size);     //十六进制字符切片转换为字节数据
+extern uint32_t strCmdParse_getSchemaErrTimes(pCpcb_t pCpcb, int cmdType);      //读取参数格式不符拒绝命令次数
+#endif
+
+#if CMD_BATCH_ENABLE
+extern bool strCmdParse_batchStart(pCmdBatchPool_t pPool, int threadNum);       //创建批量解析线程池
+extern void strCmdParse_batchStop(pCmdBatchPool_t pPool);                       //停止批量解析线程池
+extern int  strCmdParse_batchParse( pCmdBatchPool_t     pPool,                  //批量解析命令行切片数组，返回匹配到命令类型的命令行数
+                                    pCpcb_t             pCpcb,
+                                    const cmdSlice_t    *pLineArr,
+                                    int                 lineNum,
+                                    cmdBatchResult_t    *pResArr);
+extern int  strCmdParse_batchParseBuf(  pCmdBatchPool_t     pPool,              //批量解析缓冲区中按偏移给出的命令行，返回匹配到命令类型的命令行数
+                                        pCpcb_t             pCpcb,
+                                        const char          *pBuf,
+                                        const uint32_t      *pOffArr,
+                                        int                 lineNum,
+                                        cmdBatchResult_t    *pResArr);
+#if CMD_ARGV_ENABLE
+extern bool strCmdParse_batchArgv(const char *pLine, const cmdBatchResult_t *pRes, cmdArgv_t *pArgv);  //展开批量解析结果的参数向量
+#endif
+#endif
+
+#if CMD_PARA_QUEUE_ENABLE && CMD_PARA_DROP_COUNT_ENABLE
+extern uint32_t strCmdParse_getParaDropTimes(pCpcb_t pCpcb, int cmdType);       //读取命令参数队列丢弃命令次数
+#endif
+
 #ifdef __cplusplus
 }
 #endif
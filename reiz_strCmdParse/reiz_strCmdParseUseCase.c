@@ -15,12 +15,17 @@
  *      例：#define CMD_TYPE_GET_BATTERY_LEVEL    1
  *  4.建立和完善命令类型元素数组 cmdTypeElement_t，保证最后一行为{0, 0}
  *      例：static cmdTypeElement_t cmdTypeEleArr[] = {}
+ *    使能 CMD_SCHEMA_ENABLE 时可在第三列给出参数格式字符串，格式不符的命令不调度
+ *      例：{ CMD_TYPE_SET_DEVICE_NAME, "SetDeviceName", "s" }
  *  5.定义 cpcb_t 命令解析控制块变量和 PROTOCOL_PARSE_OJB(MATRIX_ROW) 协议对象变量
  *      例：static cpcb_t cpcb;                     
  *      例：static STR_CMD_PARSE_OJB(MATRIX_ROW) cmdParseObj;
  *  6.注册各命令回调函数 registerCmdCB();
  *  7.初始化命令解析控制块 cpcbInit();
+ *    多个连接共用同一命令类型元素数组时，先以 strCmdParse_dictInit() 编译一次命令字典，
+ *    各连接再以 strCmdParse_cpcbInitDict() 初始化各自的控制块
  *  8.APP中执行命令解析和命令处理
+ *  9.使能 CMD_BATCH_ENABLE 时调用 strCmdBatchBenchmark() 比较不同工作线程数的批量解析吞吐量
  */
 
 /* Includes ------------------------------------------------------------------*/
@@ -29,6 +34,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if CMD_BATCH_ENABLE
+#include <time.h>
+#endif
 
 /* Private define ------------------------------------------------------------*/
 
@@ -43,6 +51,10 @@
 #define CMD_TYPE_SET_DEVICE_NAME        3           //设置设备名
 #define CMD_TYPE_GET_TEMPERATURE        4           //获取温度值
 
+/* 批量解析基准测试参数：命令行数、每个线程数的解析遍数 */
+#define CMD_BATCH_BENCH_LINE_NUM        65536
+#define CMD_BATCH_BENCH_PASS_NUM        20
+
 /* Private macro -------------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
 
@@ -53,13 +65,31 @@ static STR_CMD_PARSE_OJB(MATRIX_ROW) cmdParseObj;
 
 //定义命令类型及命令类型字符串
 static cmdTypeElement_t cmdTypeEleArr[] = {
+#if CMD_SCHEMA_ENABLE
+    { CMD_TYPE_GET_BATTERY_LEVEL    ,   "GetBatteryLevel"   ,   NULL    },
+    { CMD_TYPE_GET_SIGNAL_STRENGTH  ,   "GetSignalStrength" ,   NULL    },
+    { CMD_TYPE_SET_DEVICE_NAME      ,   "SetDeviceName"     ,   NULL    },
+    { CMD_TYPE_GET_TEMPERATURE      ,   "GetTemperature"    ,   NULL    },
+    { 0                             ,   0                   ,   NULL    }       //此行必须有，作为数组结束行！
+#else
     { CMD_TYPE_GET_BATTERY_LEVEL    ,   "GetBatteryLevel"   },
     { CMD_TYPE_GET_SIGNAL_STRENGTH  ,   "GetSignalStrength" },
     { CMD_TYPE_SET_DEVICE_NAME      ,   "SetDeviceName"     },
     { CMD_TYPE_GET_TEMPERATURE      ,   "GetTemperature"    },
     { 0                             ,   0                   }                   //此行必须有，作为数组结束行！
+#endif
 };
 
+#if CMD_BATCH_ENABLE
+static cmdDict_t batchBenchDict;                                                //批量解析基准测试命令字典
+static cpcb_t batchBenchCpcb;                                                   //批量解析基准测试命令解析控制块
+static STR_CMD_PARSE_OJB(MATRIX_ROW) batchBenchObj;                             //批量解析基准测试协议命令解析对象
+static cmdBatchPool_t batchBenchPool;                                           //批量解析基准测试线程池
+static char batchBenchBuf[CMD_BATCH_BENCH_LINE_NUM * 32];                       //批量解析基准测试命令行缓冲区
+static uint32_t batchBenchOffArr[CMD_BATCH_BENCH_LINE_NUM + 1];                 //批量解析基准测试各命令行起始偏移
+static cmdBatchResult_t batchBenchResArr[CMD_BATCH_BENCH_LINE_NUM];             //批量解析基准测试结果数组
+#endif
+
 /* Exported variables --------------------------------------------------------*/
 
 extern pCpcb_t pCpcb = &cpcb;
@@ -70,6 +100,9 @@ static void GetBatteryLevel_ProcesCB(void *pPara);
 static void GetSignalStrength_ProcesCB(void *pPara);
 static void SetDeviceName_ProcesCB(void *pPara);
 static void GetTemperature_ProcesCB(void *pPara);
+#if CMD_BATCH_ENABLE
+static double strCmdBatchBenchRun(int threadNum);
+#endif
 
 /*******************************************************************************
 *  @brief  注册协议命令回调函数
@@ -109,16 +142,42 @@ static void GetSignalStrength_ProcesCB(void *pPara) {
  *  @return void
  */
 static void SetDeviceName_ProcesCB(void *pPara) {
-    char *p1, *p2;
+#if CMD_ARGV_ENABLE
+    const cmdArgv_t *pArgv = (const cmdArgv_t *)pPara;                          //参数已于解析时切分："CMD" "SetDeviceName" 设备名...
+    const char *p1, *p2;
+
+    if (pArgv->argc < 3) {
+        return;
+    }
+    p1 = pArgv->argv[2].pStr;
+    p2 = pArgv->argv[pArgv->argc - 1].pStr + pArgv->argv[pArgv->argc - 1].len;
 
-    p1 = strstr((char const*)pPara, cmdTypeEleArr[CMD_TYPE_SET_DEVICE_NAME - 1].pCmdTypeStr);
-    p1 = strstr(p1, " ");
-    p1++;
+    printf("Device Name is: %.*s \n", (int)(p2 - p1), p1);
+#else
+    const char *pStr, *pEnd, *p1, *p2;
+    int n;
 
-    p2 = strstr((char const*)pPara, "\r\n");
-    *p2 = '\0';
+#if CMD_ZERO_COPY_ENABLE
+    pStr = ((cmdSlice_t *)pPara)->pStr;                                         //命令切片借用输入缓冲区，不以'\0'结尾且不可写入
+    pEnd = pStr + ((cmdSlice_t *)pPara)->len;
+#else
+    pStr = (const char *)pPara;
+    pEnd = pStr + strlen(pStr);
+#endif
 
-    printf("Device Name is: %s \n", p1);
+    for (p1 = pStr, n = 0; p1 < pEnd && n < 2; p1++) {                          //跳过 "CMD" 及命令类型字符串
+        if (*p1 == ' ') {
+            n++;
+        }
+    }
+    if (n < 2) {
+        return;
+    }
+
+    for (p2 = p1; p2 < pEnd && *p2 != '\r' && *p2 != '\n'; p2++);              //设备名至行尾
+
+    printf("Device Name is: %.*s \n", (int)(p2 - p1), p1);
+#endif
 }
 
 /*******************************************************************************
@@ -137,12 +196,24 @@ static void GetTemperature_ProcesCB(void *pPara) {
 *  @return  void
 */
 extern void cmdParseInit(void) {
+#if CMD_DICT_EMBED_ENABLE
     strCmdParse_cpcbInit(   pCpcb,
                             MATRIX_ROW, 
                             (pCmdTypeEleArr_t)cmdTypeEleArr,
                             (pFlagMatrix_t)cmdParseObj.flagMatrix,
                             (pCbMatrix_t)cmdParseObj.cbMatrix,
                             (pParaMatrix_t)cmdParseObj.paraMatrix);
+#else
+    static cmdDict_t cmdDict;                                                   //共享命令字典，多个连接的控制块可同时引用
+
+    strCmdParse_dictInit(&cmdDict, (pCmdTypeEleArr_t)cmdTypeEleArr);
+    strCmdParse_cpcbInitDict(   pCpcb,
+                                MATRIX_ROW,
+                                &cmdDict,
+                                (pFlagMatrix_t)cmdParseObj.flagMatrix,
+                                (pCbMatrix_t)cmdParseObj.cbMatrix,
+                                (pParaMatrix_t)cmdParseObj.paraMatrix);
+#endif
     registerAllCmdCB();
 }
 
@@ -178,5 +249,79 @@ extern void strCmdParseTest(void) {
     strCmdParse_cmdProcess(pCpcb);
 }
 
+#if CMD_BATCH_ENABLE
+/*******************************************************************************
+ *  @brief  批量解析基准测试函数，随机生成命令行，工作线程数0~CMD_BATCH_THREAD_MAX，
+ *          分别统计每秒解析命令行数及相对调用线程单独解析的加速比，输出线程数含调用线程
+ *  @param  void
+ *  @return void
+ */
+extern void strCmdBatchBenchmark(void) {
+    uint32_t seed = 12345;
+    double baseRate = 0, rate;
+    int i, n, len, eleNum, threadNum;
+
+    for (eleNum = 0; cmdTypeEleArr[eleNum].cmdType != 0; eleNum++);
+    if (!strCmdParse_dictInit(&batchBenchDict, (pCmdTypeEleArr_t)cmdTypeEleArr) ||
+        !strCmdParse_cpcbInitDict(  &batchBenchCpcb,
+                                    MATRIX_ROW,
+                                    &batchBenchDict,
+                                    (pFlagMatrix_t)batchBenchObj.flagMatrix,
+                                    (pCbMatrix_t)batchBenchObj.cbMatrix,
+                                    (pParaMatrix_t)batchBenchObj.paraMatrix)) {
+        strCmdParse_dictDeinit(&batchBenchDict);
+        return;
+    }
+
+    for (i = 0, len = 0; i < CMD_BATCH_BENCH_LINE_NUM; i++) {                   //线性同余随机数，约1/8命令行不匹配任何命令类型
+        seed = seed * 1103515245 + 12345;
+        n = (seed >> 8) % (eleNum * 8);
+        batchBenchOffArr[i] = len;
+        len += sprintf(&batchBenchBuf[len], "CMD %s %u\r\n",
+                       n < eleNum * 7 ? cmdTypeEleArr[n % eleNum].pCmdTypeStr : "Unknown", seed & 0xFFFF);
+    }
+    batchBenchOffArr[i] = len;
+
+    for (threadNum = 0; threadNum <= CMD_BATCH_THREAD_MAX; threadNum = threadNum ? threadNum * 2 : 1) {
+        rate = strCmdBatchBenchRun(threadNum);
+        if (threadNum == 0) {
+            baseRate = rate;
+        }
+        printf("threads: %2d, %7.2f Mline/s, speedup: %.2f\n",
+               threadNum + 1, rate / 1e6, baseRate > 0 ? rate / baseRate : 0);
+    }
+
+    strCmdParse_cpcbDeinit(&batchBenchCpcb);
+    strCmdParse_dictDeinit(&batchBenchDict);
+}
+
+/*******************************************************************************
+ *  @brief  执行一轮批量解析基准测试
+ *  @param  threadNum - 工作线程数，不含调用线程
+ *  @return 每秒解析命令行数，失败返回0
+ */
+static double strCmdBatchBenchRun(int threadNum) {
+    struct timespec begin, end;
+    int i;
+
+    if (!strCmdParse_batchStart(&batchBenchPool, threadNum)) {
+        return 0;
+    }
+
+    strCmdParse_batchParseBuf(  &batchBenchPool, &batchBenchCpcb, batchBenchBuf,    //预热，工作线程就绪
+                                batchBenchOffArr, CMD_BATCH_BENCH_LINE_NUM, batchBenchResArr);
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    for (i = 0; i < CMD_BATCH_BENCH_PASS_NUM; i++) {
+        strCmdParse_batchParseBuf(  &batchBenchPool, &batchBenchCpcb, batchBenchBuf,
+                                    batchBenchOffArr, CMD_BATCH_BENCH_LINE_NUM, batchBenchResArr);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    strCmdParse_batchStop(&batchBenchPool);
+
+    return (double)CMD_BATCH_BENCH_LINE_NUM * CMD_BATCH_BENCH_PASS_NUM
+           / ((end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) / 1e9);
+}
+#endif
+
 /******************************** END OF FILE **********************************
 *************************** (C) Copyright 2019 REIZ ***************************/
@@ -18,6 +18,8 @@ extern "C"
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include "reiz_strCmdParse.h"
+
 /* Exported define -----------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
@@ -25,6 +27,9 @@ extern "C"
 
 /* Exported functions prototypes ---------------------------------------------*/
 extern void strCmdParseTest(void);
+#if CMD_BATCH_ENABLE
+extern void strCmdBatchBenchmark(void);
+#endif
 
 #ifdef __cplusplus
 }